@@ -0,0 +1,551 @@
+// Headless latency harness. Builds a synthetic directory tree, replays a
+// recorded (or built-in) input sequence through FileBrowserApp on SDL's dummy
+// video driver with the software renderer at the recording's own timing, and
+// reports per-action frame time percentiles. Exits with 1 when any action's
+// p95 exceeds the budget, when an idle, move selection or scroll frame
+// allocates from the heap, or when the scroll check covered too little (no
+// prefetch worker, no scroll frames, or more than 5% of them missed the row
+// cache), so it can gate a CI job. Allocations are counted on the render thread only, through
+// operator new and SDL's allocator; FreeType's own allocator is not covered.
+//
+//   event_replay <font.ttf> [--events file] [--save-events file] [--entries N]
+//                [--budget-ms N] [--mode auto|renderer|framebuffer] [--compare-modes]
+//                [--listing-bench passes] [--ext extension]...
+//
+// --listing-bench only times listing the generated root, e.g. --entries 200000 --ext png.
+#include "app/FileBrowserApp.h"
+#include "app/EventRecorder.h"
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// Every C++ and SDL heap allocation goes through here so frames can be checked for allocations.
+// The counter is per thread so the text rasterizer's worker does not show up in render frames.
+static thread_local size_t t_allocationCount = 0;
+
+static SDL_malloc_func g_sdlMalloc;
+static SDL_calloc_func g_sdlCalloc;
+static SDL_realloc_func g_sdlRealloc;
+static SDL_free_func g_sdlFree;
+
+static void *SDLCALL countingMalloc(size_t size)
+{
+    ++t_allocationCount;
+    return g_sdlMalloc(size);
+}
+
+static void *SDLCALL countingCalloc(size_t count, size_t size)
+{
+    ++t_allocationCount;
+    return g_sdlCalloc(count, size);
+}
+
+static void *SDLCALL countingRealloc(void *mem, size_t size)
+{
+    ++t_allocationCount;
+    return g_sdlRealloc(mem, size);
+}
+
+// Must run before any other SDL call so nothing is freed with the wrong allocator
+static void installSDLAllocationCounter()
+{
+    SDL_GetMemoryFunctions(&g_sdlMalloc, &g_sdlCalloc, &g_sdlRealloc, &g_sdlFree);
+    SDL_SetMemoryFunctions(countingMalloc, countingCalloc, countingRealloc, g_sdlFree);
+}
+
+void *operator new(std::size_t size)
+{
+    ++t_allocationCount;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+const int SCREEN_WIDTH = 854;
+const int SCREEN_HEIGHT = 480;
+const int FONT_SIZE = 24;
+
+const int REPLAY_FRAME_RATE = 60;
+// Scroll frames may rasterize a row themselves this often at most, beyond that the prefetch is
+// not keeping up and the zero-allocation check on "scroll" would cover too little
+const double MAX_SCROLL_MISS_SHARE = 0.05;
+const Uint32 SESSION_KEY_INTERVAL_MS = 33;
+
+const int FIXTURE_DIRECTORIES = 20;
+const int FILES_PER_SUBDIRECTORY = 200;
+
+// Root holds FIXTURE_DIRECTORIES subdirectories and fileCount files, each subdirectory holds
+// FILES_PER_SUBDIRECTORY files. One root file in 100 is a .png, the rest alternate between
+// .txt and .dat, so --ext png keeps 1% of them. Names are fixed so runs are comparable.
+static bool createFixture(const fs::path &root, int fileCount)
+{
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    if (!fs::create_directories(root, ec))
+    {
+        std::cerr << "Could not create fixture " << root << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    char name[64];
+    for (int d = 0; d < FIXTURE_DIRECTORIES; ++d)
+    {
+        std::snprintf(name, sizeof(name), "dir_%03d", d);
+        fs::path dir = root / name;
+        fs::create_directory(dir, ec);
+        for (int f = 0; f < FILES_PER_SUBDIRECTORY; ++f)
+        {
+            std::snprintf(name, sizeof(name), "nested_file_%05d.dat", f);
+            std::ofstream(dir / name);
+        }
+    }
+    for (int f = 0; f < fileCount; ++f)
+    {
+        std::snprintf(name, sizeof(name), "file_%06d.%s", f, f % 100 == 0 ? "png" : (f % 2 ? "dat" : "txt"));
+        std::ofstream(root / name);
+    }
+    return true;
+}
+
+static SDL_Event keyEvent(SDL_Keycode sym, Uint32 timestamp)
+{
+    SDL_Event e;
+    std::memset(&e, 0, sizeof(e));
+    e.type = SDL_KEYDOWN;
+    e.common.timestamp = timestamp;
+    e.key.state = SDL_PRESSED;
+    e.key.keysym.sym = sym;
+    return e;
+}
+
+static void pushKeys(std::vector<SDL_Event> &events, SDL_Keycode sym, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        events.push_back(keyEvent(sym, (Uint32)events.size() * SESSION_KEY_INTERVAL_MS));
+    }
+}
+
+// Built-in session for the fixture above: browse into and out of a few subdirectories,
+// scroll through their listings and the root listing, then select a file. Keys are spaced
+// like a held key repeating.
+static std::vector<SDL_Event> defaultSession()
+{
+    std::vector<SDL_Event> events;
+    for (int d = 0; d < 3; ++d)
+    {
+        pushKeys(events, SDLK_DOWN, 1 + d); // Past ".." onto dir_00d
+        pushKeys(events, SDLK_RETURN, 1);
+        pushKeys(events, SDLK_DOWN, 60);
+        pushKeys(events, SDLK_UP, 20);
+        pushKeys(events, SDLK_BACKSPACE, 1);
+    }
+    pushKeys(events, SDLK_DOWN, FIXTURE_DIRECTORIES + 40);
+    pushKeys(events, SDLK_UP, 10);
+    pushKeys(events, SDLK_RETURN, 1);
+    return events;
+}
+
+static double percentile(std::vector<double> samples, double p)
+{
+    if (samples.empty())
+    {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t rank = (size_t)std::ceil(p * samples.size());
+    return samples[std::min(samples.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+// When several events land in one frame, the frame is reported under the heaviest of them
+static int actionRank(FileBrowserApp::Action action)
+{
+    switch (action)
+    {
+    case FileBrowserApp::Action::NavigateUp:
+    case FileBrowserApp::Action::NavigateDown:
+        return 1;
+    case FileBrowserApp::Action::None:
+        return 0;
+    case FileBrowserApp::Action::NavigateParent:
+    case FileBrowserApp::Action::SelectConfirm:
+        return 3;
+    default:
+        return 2;
+    }
+}
+
+// Selection moves that shift the list are reported separately, they bring new rows on screen.
+// Those rows come from the prefetched row cache; a row the prefetch had not delivered yet is
+// rasterized during the frame, which allocates, so such frames get their own line.
+static const char *actionName(FileBrowserApp::Action action, bool finished, bool scrolled, bool cacheMissed)
+{
+    switch (action)
+    {
+    case FileBrowserApp::Action::NavigateUp:
+    case FileBrowserApp::Action::NavigateDown:
+        if (!scrolled)
+            return "move selection";
+        return cacheMissed ? "scroll (miss)" : "scroll";
+    case FileBrowserApp::Action::NavigateParent:
+        return "go up";
+    case FileBrowserApp::Action::SelectConfirm:
+        return finished ? "select" : "open directory";
+    default:
+        return "other";
+    }
+}
+
+struct ReplayResult
+{
+    std::map<std::string, std::vector<double>> samples;  // Frame times in ms by action
+    std::map<std::string, size_t> maxAllocations;        // Largest render-thread allocation count by action
+    bool rowPrefetchRunning = false;
+};
+
+// Replays events through a fresh FileBrowserApp drawing in mode. Returns false if the app fails to start.
+static bool replaySession(SDL_Window *window, SDL_Renderer *renderer, const std::string &fontPath,
+                          UIManager::RenderMode mode, const FileFilter &filter,
+                          const std::vector<SDL_Event> &events, ReplayResult &result)
+{
+    FileBrowserApp app;
+    app.setRenderMode(mode);
+    app.setJumpListPath(""); // Replays must not touch the user's jump list
+    app.setFileFilter(filter);
+    if (!app.init(window, renderer, fontPath, FONT_SIZE))
+    {
+        std::cerr << "FileBrowserApp initialization failed!" << std::endl;
+        return false;
+    }
+    result.rowPrefetchRunning = app.getUIManager()->isRowPrefetchRunning();
+
+    const double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    const Uint64 frameTicks = SDL_GetPerformanceFrequency() / REPLAY_FRAME_RATE;
+    app.updateAndRender(); // First frame, not representative of steady state
+
+    // Frames are paced like the standalone loop and every event whose timestamp has passed is
+    // handled in the next frame, so bursts and pauses in the recording are reproduced
+    const Uint64 replayStart = SDL_GetPerformanceCounter();
+    size_t nextEvent = 0;
+    while (nextEvent < events.size() && !app.isDone())
+    {
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        double replayMs = (frameStart - replayStart) / ticksPerMs;
+        int scrollOffsetBefore = app.getFileBrowser()->getScrollOffset();
+        Uint32 rowCacheMissesBefore = app.getFrameStats().rowCacheMisses;
+        FileBrowserApp::Action frameAction = FileBrowserApp::Action::None;
+        bool hadInput = false;
+
+        size_t allocationsBefore = t_allocationCount;
+        for (; nextEvent < events.size() && events[nextEvent].common.timestamp <= replayMs; ++nextEvent)
+        {
+            SDL_Event e = events[nextEvent];
+            FileBrowserApp::Action action = FileBrowserApp::actionForEvent(e);
+            if (!hadInput || actionRank(action) > actionRank(frameAction))
+                frameAction = action;
+            hadInput = true;
+            e.common.timestamp = SDL_GetTicks();
+            app.handleInput(e);
+        }
+        app.updateAndRender();
+        double elapsedMs = (SDL_GetPerformanceCounter() - frameStart) / ticksPerMs;
+        size_t allocations = t_allocationCount - allocationsBefore;
+
+        const char *name = "idle";
+        if (hadInput)
+        {
+            bool scrolled = app.getFileBrowser()->getScrollOffset() != scrollOffsetBefore;
+            bool cacheMissed = app.getFrameStats().rowCacheMisses != rowCacheMissesBefore;
+            name = actionName(frameAction, app.isDone(), scrolled, cacheMissed);
+        }
+        result.samples[name].push_back(elapsedMs);
+        result.maxAllocations[name] = std::max(result.maxAllocations[name], allocations);
+
+        Uint64 frameElapsed = SDL_GetPerformanceCounter() - frameStart;
+        if (frameElapsed < frameTicks)
+        {
+            SDL_Delay((Uint32)((frameTicks - frameElapsed) / ticksPerMs));
+        }
+    }
+    return true;
+}
+
+// Prints one line per action and returns true when every action is within budget, the frames
+// that must not allocate did not, and the scroll check actually ran on prefetched rows
+static bool reportResult(const ReplayResult &result, double budgetMs)
+{
+    bool withinBudget = true;
+    bool allocationFree = true;
+    std::printf("%-16s %7s %9s %9s %9s %9s %11s\n", "action", "count", "p50 ms", "p95 ms", "p99 ms", "max ms", "max allocs");
+    for (const auto &[name, times] : result.samples)
+    {
+        double p95 = percentile(times, 0.95);
+        size_t allocations = result.maxAllocations.at(name);
+        // Frames that only redraw or move through the listing must not touch the heap,
+        // the rest load directories and may
+        bool mustNotAllocate = name == "idle" || name == "move selection" || name == "scroll";
+        std::printf("%-16s %7zu %9.2f %9.2f %9.2f %9.2f %11zu%s%s\n", name.c_str(), times.size(),
+                    percentile(times, 0.50), p95, percentile(times, 0.99), percentile(times, 1.0), allocations,
+                    p95 > budgetMs ? "  OVER BUDGET" : "",
+                    mustNotAllocate && allocations > 0 ? "  ALLOCATES" : "");
+        if (p95 > budgetMs)
+            withinBudget = false;
+        if (mustNotAllocate && allocations > 0)
+            allocationFree = false;
+    }
+
+    bool scrollChecked = true;
+    auto scrolls = result.samples.find("scroll");
+    auto misses = result.samples.find("scroll (miss)");
+    size_t scrollCount = scrolls != result.samples.end() ? scrolls->second.size() : 0;
+    size_t missCount = misses != result.samples.end() ? misses->second.size() : 0;
+    if (!result.rowPrefetchRunning)
+    {
+        std::cerr << "The row prefetch worker did not start, every scroll frame rasterizes on the render thread." << std::endl;
+        scrollChecked = false;
+    }
+    if (scrollCount == 0)
+    {
+        std::cerr << "No scroll frame was served from the row cache, the session must scroll." << std::endl;
+        scrollChecked = false;
+    }
+    else if (missCount > (scrollCount + missCount) * MAX_SCROLL_MISS_SHARE)
+    {
+        std::cerr << missCount << " of " << scrollCount + missCount << " scroll frames rasterized rows themselves, more than "
+                  << MAX_SCROLL_MISS_SHARE * 100 << "%." << std::endl;
+        scrollChecked = false;
+    }
+
+    if (!withinBudget)
+        std::cerr << "p95 frame time exceeded the " << budgetMs << " ms budget." << std::endl;
+    if (!allocationFree)
+        std::cerr << "Idle, move selection or scroll frames performed heap allocations." << std::endl;
+    return withinBudget && allocationFree && scrollChecked;
+}
+
+// Times listing the current directory on its own, without SDL. Every pass starts from a cleared
+// listing cache so it reads the directory.
+static void runListingBench(const FileFilter &filter, int passes)
+{
+    const double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    std::vector<double> times;
+    size_t maxAllocations = 0;
+    size_t itemCount = 0;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        FileBrowser::clearListingCache();
+        size_t allocationsBefore = t_allocationCount;
+        Uint64 start = SDL_GetPerformanceCounter();
+        FileBrowser browser(filter);
+        times.push_back((SDL_GetPerformanceCounter() - start) / ticksPerMs);
+        maxAllocations = std::max(maxAllocations, t_allocationCount - allocationsBefore);
+        itemCount = browser.getCurrentItems().size();
+    }
+    std::printf("%-16s %7s %9s %9s %11s\n", "listing", "items", "p50 ms", "max ms", "max allocs");
+    std::printf("%-16s %7zu %9.2f %9.2f %11zu\n", filter.getSignature().empty() ? "unfiltered" : "filtered",
+                itemCount, percentile(times, 0.50), percentile(times, 1.0), maxAllocations);
+}
+
+static const char *modeName(UIManager::RenderMode mode)
+{
+    switch (mode)
+    {
+    case UIManager::RenderMode::Renderer:
+        return "renderer";
+    case UIManager::RenderMode::Framebuffer:
+        return "framebuffer";
+    default:
+        return "auto";
+    }
+}
+
+int main(int argc, char *args[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << args[0] << " <font.ttf> [--events file] [--save-events file] [--entries N]"
+                  << " [--budget-ms N] [--mode auto|renderer|framebuffer] [--compare-modes] [--listing-bench passes]"
+                  << " [--ext extension]..." << std::endl;
+        return 2;
+    }
+
+    std::string fontPath = args[1];
+    std::string eventsPath;
+    std::string saveEventsPath;
+    int entries = 2000;
+    double budgetMs = 33.0; // Two frames at 60 Hz
+    UIManager::RenderMode mode = UIManager::RenderMode::Auto;
+    bool compareModes = false;
+    int listingBenchPasses = 0;
+    FileFilter filter;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = args[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--events" && hasValue)
+            eventsPath = args[++i];
+        else if (arg == "--save-events" && hasValue)
+            saveEventsPath = args[++i];
+        else if (arg == "--entries" && hasValue)
+            entries = std::atoi(args[++i]);
+        else if (arg == "--budget-ms" && hasValue)
+            budgetMs = std::atof(args[++i]);
+        else if (arg == "--listing-bench" && hasValue)
+            listingBenchPasses = std::atoi(args[++i]);
+        else if (arg == "--compare-modes")
+            compareModes = true;
+        else if (arg == "--ext" && hasValue)
+            filter.addExtension(args[++i]);
+        else if (arg == "--mode" && hasValue)
+        {
+            std::string value = args[++i];
+            if (value == "renderer")
+                mode = UIManager::RenderMode::Renderer;
+            else if (value == "framebuffer")
+                mode = UIManager::RenderMode::Framebuffer;
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<SDL_Event> events;
+    if (!eventsPath.empty())
+    {
+        if (!EventRecorder::load(eventsPath, events))
+            return 2;
+    }
+    else
+    {
+        events = defaultSession();
+    }
+
+    if (!saveEventsPath.empty())
+    {
+        EventRecorder recorder;
+        for (const SDL_Event &e : events)
+            recorder.record(e);
+        recorder.save(saveEventsPath);
+    }
+
+    installSDLAllocationCounter();
+
+    // Resolve the font before changing into the fixture
+    fontPath = fs::absolute(fontPath).string();
+    // One directory per process, concurrent runs (ctest -j) would otherwise delete each other's fixture
+    fs::path fixture = fs::temp_directory_path() / ("sdlfilebrowser_replay_fixture_" + std::to_string(getpid()));
+    if (!createFixture(fixture, entries))
+        return 2;
+    fs::path originalPath = fs::current_path();
+    fs::current_path(fixture);
+
+    if (listingBenchPasses > 0)
+    {
+        runListingBench(filter, listingBenchPasses);
+        fs::current_path(originalPath);
+        std::error_code ec;
+        fs::remove_all(fixture, ec);
+        return 0;
+    }
+
+    // Does not overwrite, so the environment can still pick e.g. "offscreen". The environment
+    // variable rather than SDL_HINT_VIDEODRIVER, which only exists from SDL 2.0.22.
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_VIDEO) < 0)
+    {
+        std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
+        return 2;
+    }
+
+    SDL_Window *window = SDL_CreateWindow("event_replay", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                          SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : nullptr;
+    if (!renderer)
+    {
+        std::cerr << "Window/renderer creation failed: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        return 2;
+    }
+
+    // --compare-modes runs the same session once per drawing path, each from a cold listing cache
+    std::vector<UIManager::RenderMode> modes;
+    if (compareModes)
+        modes = {UIManager::RenderMode::Renderer, UIManager::RenderMode::Framebuffer};
+    else
+        modes = {mode};
+
+    std::vector<ReplayResult> results(modes.size());
+    bool started = true;
+    for (size_t m = 0; m < modes.size() && started; ++m)
+    {
+        FileBrowser::clearListingCache();
+        started = replaySession(window, renderer, fontPath, modes[m], filter, events, results[m]);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    fs::current_path(originalPath);
+    std::error_code ec;
+    fs::remove_all(fixture, ec);
+
+    if (!started)
+        return 2;
+
+    bool passed = true;
+    for (size_t m = 0; m < modes.size(); ++m)
+    {
+        if (compareModes)
+            std::printf("%s%s mode\n", m > 0 ? "\n" : "", modeName(modes[m]));
+        if (!reportResult(results[m], budgetMs))
+            passed = false;
+    }
+    return passed ? 0 : 1;
+}
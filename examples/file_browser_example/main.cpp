@@ -1,6 +1,7 @@
 #include "app/FileBrowserApp.h"
 #include <iostream>
 #include <SDL.h>
+#include <cstring>
 
 const int SCREEN_WIDTH = 854;
 const int SCREEN_HEIGHT = 480;
@@ -9,6 +10,22 @@ const int FONT_SIZE = 24;
 int main(int argc, char* args[]) {
     std::string fontPath = "res/Roboto-Regular.ttf";
 
+    // --software forces SDL's software renderer
+    // --record <file> saves the session's input so event_replay can reproduce it
+    // --ext <extension> (repeatable) only lists files with that extension
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+    std::string recordPath;
+    FileFilter filter;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(args[i], "--software") == 0) {
+            rendererFlags = SDL_RENDERER_SOFTWARE;
+        } else if (std::strcmp(args[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = args[++i];
+        } else if (std::strcmp(args[i], "--ext") == 0 && i + 1 < argc) {
+            filter.addExtension(args[++i]);
+        }
+    }
+
     Uint32 requiredFlags = FileBrowserApp::getRequiredSDLInitFlags();
     if (SDL_Init(requiredFlags) < 0) {
         std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
@@ -23,7 +40,7 @@ int main(int argc, char* args[]) {
         return 1;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         std::cerr << "Renderer creation failed: " << SDL_GetError() << std::endl;
         SDL_DestroyWindow(window);
@@ -31,9 +48,29 @@ int main(int argc, char* args[]) {
         return 1;
     }
 
+    if (!recordPath.empty()) {
+        // The app owns textures and controllers, so it must be gone before the renderer and SDL are torn down
+        {
+            EventRecorder recorder;
+            FileBrowserApp app;
+            app.setEventRecorder(&recorder);
+            app.setFileFilter(filter);
+            if (app.init(window, renderer, fontPath, FONT_SIZE)) {
+                app.runStandaloneLoop();
+            }
+            if (recorder.save(recordPath)) {
+                std::cout << "Recorded " << recorder.getEvents().size() << " events to " << recordPath << std::endl;
+            }
+        }
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 0;
+    }
+
     // --- Demonstrate usage of the new modal dialog function ---
     std::cout << "Launching modal file selection dialog..." << std::endl;
-    std::string selectedFile = FileBrowserApp::showFileSelectionDialog(window, renderer, SCREEN_WIDTH, SCREEN_HEIGHT, fontPath, FONT_SIZE);
+    std::string selectedFile = FileBrowserApp::showFileSelectionDialog(window, renderer, SCREEN_WIDTH, SCREEN_HEIGHT, fontPath, FONT_SIZE, filter);
 
     if (!selectedFile.empty()) {
         std::cout << "Selected file: " << selectedFile << std::endl;
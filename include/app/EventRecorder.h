@@ -0,0 +1,29 @@
+#ifndef EVENTRECORDER_H
+#define EVENTRECORDER_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+// Captures the input events that drive FileBrowserApp so a session can be
+// saved to a text file and replayed later, e.g. by the event_replay harness.
+// Only key presses, controller button presses and quit are kept.
+class EventRecorder {
+public:
+    EventRecorder();
+
+    void record(const SDL_Event& e);
+    void clear();
+
+    const std::vector<SDL_Event>& getEvents() const { return events; }
+
+    // One event per line: "<ms since first event> <SDL event type> <keycode or button>"
+    bool save(const std::string& path) const;
+    static bool load(const std::string& path, std::vector<SDL_Event>& events);
+
+private:
+    std::vector<SDL_Event> events;
+    Uint32 firstTimestamp;
+};
+
+#endif // EVENTRECORDER_H
@@ -3,6 +3,8 @@
 
 #include "core/UIManager.h"
 #include "core/FileBrowser.h"
+#include "app/EventRecorder.h"
+#include "core/JumpList.h"
 #include <SDL.h>
 #include <string>
 #include <map>
@@ -22,38 +24,87 @@ public:
         NavigateDown,
         NavigateParent,
         SelectConfirm,
+        JumpToRecent,       // Cycles through bookmarks and frequently used directories
+        ToggleBookmark,
         Cancel,
         QuitApp, 
         None    
     };
 
+    // Input-to-photon measurements, from the SDL event timestamp of the first
+    // unhandled input to the return of the present that showed its result.
+    struct FrameStats {
+        Uint32 lastInputLatencyMs;
+        Uint32 maxInputLatencyMs;
+        double averageInputLatencyMs;
+        Uint32 latencySamples;
+        int refreshRate;    // Hz of the display the window is on
+        bool vsync;         // Vsync was requested; present usually blocks until vblank
+        Uint32 rowCacheMisses;  // Visible rows rasterized on the render thread since init
+    };
+
     static Uint32 getRequiredSDLInitFlags();
+    static Action actionForEvent(const SDL_Event& e);
 
     FileBrowserApp();
     ~FileBrowserApp();
 
+    // Must be called before init(); defaults to UIManager::RenderMode::Auto
+    void setRenderMode(UIManager::RenderMode mode) { m_renderMode = mode; }
+    // Every event passed to handleInput() is also handed to recorder; pass nullptr to stop
+    void setEventRecorder(EventRecorder* recorder) { m_eventRecorder = recorder; }
+    // Must be called before init(); defaults to jumplist.bin in SDL's preferences directory,
+    // an empty path keeps the jump list in memory only
+    void setJumpListPath(const std::string& path) { m_jumpListPath = path; m_jumpListPathSet = true; }
+
+    // Must be called before init(); only matching files are listed
+    void setFileFilter(const FileFilter& filter) { m_fileFilter = filter; }
+
     bool init(SDL_Window* window, SDL_Renderer* renderer, const std::string& fontPath, int fontSize);
     void updateAndRender();
     void handleInput(SDL_Event& e); 
     bool isDone() const { return !running; }
+    const FrameStats& getFrameStats() const { return m_frameStats; }
+    const FileBrowser* getFileBrowser() const { return fileBrowser; }
+    const UIManager* getUIManager() const { return uiManager; }
 
     DialogResult runStandaloneLoop();
 
     static std::string showFileSelectionDialog(SDL_Window* window, SDL_Renderer* renderer,
                                                int screenWidth, int screenHeight,
-                                               const std::string& fontPath, int fontSize);
+                                               const std::string& fontPath, int fontSize,
+                                               const FileFilter& filter = FileFilter());
 
 private:
     UIManager* uiManager;
     FileBrowser* fileBrowser;
     bool running;
+    UIManager::RenderMode m_renderMode;
+    EventRecorder* m_eventRecorder;
+    FileFilter m_fileFilter;
 
     std::map<SDL_JoystickID, SDL_GameController*> gameControllers;
 
     DialogResult m_currentDialogResult;
     std::string m_selectedFilePath;
 
+    FrameStats m_frameStats;
+    Uint64 m_frameIntervalTicks;    // One refresh interval in performance counter ticks
+    bool m_inputPending;
+    Uint32 m_pendingInputTimestamp;
+
+    JumpList m_jumpList;
+    std::string m_jumpListPath;
+    bool m_jumpListPathSet;
+    std::vector<std::string> m_jumpTargets;    // Ranking snapshot while the jump button is being cycled
+    size_t m_jumpCursor;
+
     void closeGameControllers();
+    void jumpToNextTarget();
+    // Returns true when it recorded a visit to the current directory
+    bool finishJumpCycle();
+    void configureFramePacing(SDL_Window* window, SDL_Renderer* renderer);
+    void recordPresentLatency();
 
 };
 
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <list>
+#include "core/FileFilter.h"
 
 struct FileItem {
     std::string name;
@@ -12,9 +14,11 @@ struct FileItem {
 
 class FileBrowser {
 public:
-    FileBrowser();
+    explicit FileBrowser(const FileFilter& filter = FileFilter());
 
-    std::string getCurrentPath() const { return currentPath.string(); }
+    const std::string& getCurrentPath() const { return currentPathString; }
+    // Changes every time the listing is rebuilt, so renderers can key caches on it
+    unsigned int getListingGeneration() const { return listingGeneration; }
     const std::vector<FileItem>& getCurrentItems() const { return currentItems; }
     int getSelectedIndex() const { return selectedIndex; }
     int getScrollOffset() const { return scrollOffset; }
@@ -24,18 +28,46 @@ public:
     void selectPreviousItem();
     void tryOpenSelectedItem();
     void goUpDirectory();
+    // Returns false, leaving the current directory alone, when path is not a readable directory
+    bool navigateTo(const std::filesystem::path& path);
 
     void setVisibleItemsCount(int count);
+    // Re-lists the current directory with only the entries filter accepts
+    void setFilter(const FileFilter& filter);
+    const FileFilter& getFilter() const { return filter; }
+
+    // Forgets every cached listing, so the next visit to any directory rescans it
+    static void clearListingCache();
 
 private:
+    // A listing kept after leaving its directory. It is reused on return for as long as the
+    // directory's modification time is unchanged and the scan started clearly after that time.
+    struct CachedListing {
+        std::string path;
+        std::string filterSignature;
+        std::filesystem::file_time_type writeTime;
+        std::filesystem::file_time_type scanTime;
+        std::vector<FileItem> items;
+    };
+
     std::filesystem::path currentPath;
+    std::string currentPathString;
+    unsigned int listingGeneration;
     std::vector<FileItem> currentItems;
     int selectedIndex;
     int scrollOffset;
 
     int visibleItemsCount;
+    std::filesystem::file_time_type currentWriteTime;
+    std::filesystem::file_time_type currentScanTime;
+    FileFilter filter;
+
+    // Shared by every FileBrowser so a new dialog session can jump straight into a known listing
+    static std::list<CachedListing>& listingCache();
 
     void listDirectory(const std::filesystem::path& path);
+    void stashCurrentListing();
+    bool takeCachedListing(const std::string& path, std::filesystem::file_time_type writeTime);
 };
 
 #endif // FILEBROWSER_H
@@ -0,0 +1,66 @@
+#ifndef FILEFILTER_H
+#define FILEFILTER_H
+
+#include <bitset>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Decides which directory entries FileBrowser lists. It is applied while the
+// directory is being read, before a FileItem is built, so entries that do not
+// match never take a place in the sort. On POSIX the name test runs on the
+// name readdir() returned and costs no allocation; the directory_entry a
+// predicate receives is only built when a predicate is set.
+//
+// A file is listed when it matches any extension or any glob (or when neither
+// is set) and the predicate, if any, accepts it. Directories skip the
+// extension and glob tests so navigation keeps working, but the predicate
+// still sees them.
+class FileFilter {
+public:
+    using Predicate = std::function<bool(const std::filesystem::directory_entry&)>;
+
+    FileFilter();
+
+    // Case insensitive, with or without the leading dot: "png", ".PNG". Only the text after the
+    // last dot is compared, use a glob such as "*.tar.gz" for compound extensions.
+    FileFilter& addExtension(std::string_view extension);
+    // Case sensitive; supports '*', '?', and classes such as "[abc]", "[a-z]" and "[!0-9]"
+    FileFilter& addGlob(std::string_view pattern);
+    FileFilter& setPredicate(Predicate predicate);
+
+    bool isEmpty() const { return extensions.empty() && globs.empty() && !predicate; }
+    bool hasPredicate() const { return (bool)predicate; }
+
+    // name is the entry's file name without its directory
+    bool acceptsName(std::string_view name) const;
+    bool acceptsEntry(const std::filesystem::directory_entry& entry) const { return !predicate || predicate(entry); }
+
+    // Identifies the extension and glob set; predicates cannot be compared and are not part of it
+    const std::string& getSignature() const { return signature; }
+
+private:
+    struct GlobToken {
+        enum class Kind { Literal, AnyChar, AnyRun, Class } kind;
+        char literal;
+        std::bitset<256> chars;
+    };
+
+    std::vector<std::string> extensions;        // Lower case, without the dot
+    std::unordered_set<uint64_t> extensionHashes;
+    size_t maxExtensionLength;
+    std::vector<std::vector<GlobToken>> globs;
+    Predicate predicate;
+    std::string signature;
+
+    bool matchesExtension(std::string_view name) const;
+    static bool matchesGlob(const std::vector<GlobToken>& glob, std::string_view name);
+    static std::vector<GlobToken> compileGlob(std::string_view pattern);
+    static uint64_t hashLowerCase(std::string_view text);
+};
+
+#endif // FILEFILTER_H
@@ -0,0 +1,44 @@
+#ifndef JUMPLIST_H
+#define JUMPLIST_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct JumpEntry {
+    std::string path;
+    uint32_t visitCount;
+    int64_t lastVisit;      // Seconds since the epoch
+    bool bookmarked;
+};
+
+// Bookmarks and recently opened directories, ranked by frecency (visit count
+// weighted by how recently the directory was last visited). Persisted as a
+// small binary file that is read in one call at startup.
+class JumpList {
+public:
+    JumpList();
+
+    bool load(const std::string& filePath);
+    bool save(const std::string& filePath) const;
+
+    void recordVisit(const std::string& directory, int64_t now);
+    // Returns true when directory is bookmarked afterwards
+    bool toggleBookmark(const std::string& directory, int64_t now);
+
+    // Bookmarks first, then recent directories, each best score first
+    std::vector<std::string> rankedPaths(int64_t now) const;
+
+    bool isDirty() const { return dirty; }
+
+private:
+    std::vector<JumpEntry> entries;
+    bool dirty;
+
+    JumpEntry& findOrAdd(const std::string& directory, int64_t now);
+    void ageVisits(const std::string& keep);
+    void evictOverflow(int64_t now, const std::string& keep);
+    static double frecency(const JumpEntry& entry, int64_t now);
+};
+
+#endif // JUMPLIST_H
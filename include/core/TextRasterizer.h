@@ -0,0 +1,72 @@
+#ifndef TEXTRASTERIZER_H
+#define TEXTRASTERIZER_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Renders row labels into surfaces on a worker thread. TTF_Font is not thread safe,
+// so the worker opens its own font and nothing else ever touches it. Surfaces are
+// handed back to the render thread, which turns them into textures or blits them.
+//
+// Jobs and results are fixed size and live in vectors reserved at start(), so
+// submitting and collecting never allocate.
+class TextRasterizer
+{
+public:
+    static const int MAX_TEXT_BYTES = 260; // NAME_MAX, a directory slash and the terminator
+
+    struct Job
+    {
+        Uint32 listingGeneration;
+        int itemIndex;
+        char text[MAX_TEXT_BYTES];
+    };
+
+    struct Result
+    {
+        Uint32 listingGeneration;
+        int itemIndex;
+        SDL_Surface *surface;   // Owned by whoever holds the Result
+    };
+
+    TextRasterizer(const std::string &fontPath, int fontSize, SDL_Color color);
+    ~TextRasterizer();
+
+    // Opens the worker's font on the calling thread and starts the worker
+    bool start(size_t maxJobs);
+    void stop();
+
+    size_t getMaxJobs() const { return maxJobs; }
+
+    // Replaces every job the worker has not started with jobs, in order. jobs is left empty
+    // with at least getMaxJobs() capacity so the caller can reuse it.
+    void submit(std::vector<Job> &jobs);
+
+    // Moves finished results into out, which must be empty
+    void collectResults(std::vector<Result> &out);
+
+private:
+    std::string fontPath;
+    int fontSize;
+    SDL_Color color;
+    TTF_Font *font;
+    size_t maxJobs;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool stopping;
+
+    std::vector<Job> pending;
+    size_t nextJob;
+    std::vector<Result> results;
+
+    void run();
+};
+
+#endif // TEXTRASTERIZER_H
@@ -5,6 +5,7 @@
 #include <SDL_ttf.h>
 #include <string>
 #include <vector>
+#include "core/TextRasterizer.h"
 
 struct FileItem;
 
@@ -14,16 +15,27 @@ extern const int LINE_HEIGHT;
 class UIManager
 {
 public:
+    enum class RenderMode {
+        Auto,           // Renderer for now, Framebuffer has to be chosen explicitly
+        Renderer,       // Every primitive and text run goes through SDL_Renderer
+        Framebuffer     // Draw into a CPU framebuffer, upload only changed rows to one streaming texture
+    };
+
     UIManager(SDL_Window *window, SDL_Renderer *renderer, int screenWidth, int screenHeight, const std::string &fontPath, int fontSize);
     ~UIManager();
 
+    // Must be called before init()
+    void setRenderMode(RenderMode mode) { renderMode = mode; }
+    RenderMode getRenderMode() const { return renderMode; }
+
     bool init();
 
     void clearRenderer();
     void presentRenderer();
 
     void drawCurrentPath(const std::string &path);
-    void drawFileList(const std::vector<FileItem> &items, int selectedIndex, int scrollOffset, int visibleItemsCount);
+    // listingGeneration identifies the listing items came from, see FileBrowser::getListingGeneration()
+    void drawFileList(const std::vector<FileItem> &items, Uint32 listingGeneration, int selectedIndex, int scrollOffset, int visibleItemsCount);
     void drawHelpText(const std::string &text, int visibleItemsCount);
 
     void drawScrollbar(int totalItems, int visibleItems, int scrollOffset);
@@ -31,8 +43,28 @@ public:
     int getScreenWidth() const;
     int getScreenHeight() const;
     int getFontSize() const { return fontSize; }
+    Uint32 getRowCacheMisses() const { return rowCacheMisses; }
+    // False when the worker font could not be opened and every row is rasterized on the render thread
+    bool isRowPrefetchRunning() const { return rowRasterizer != nullptr; }
 
 private:
+    // A string and its rasterized form: a texture in Renderer mode, an ARGB8888 surface in Framebuffer mode
+    struct CachedText
+    {
+        std::string text;
+        SDL_Texture *texture = nullptr;
+        SDL_Surface *surface = nullptr;
+        int w = 0;
+        int h = 0;
+    };
+
+    struct CachedRow
+    {
+        Uint32 listingGeneration = 0;
+        int itemIndex = -1;
+        CachedText text;
+    };
+
     SDL_Window *m_window;
     SDL_Renderer *m_renderer;
     TTF_Font *font;
@@ -41,7 +73,48 @@ private:
     int fontSize;
     std::string fontPath;
 
-    void drawText(const std::string &text, int x, int y, SDL_Color color);
+    RenderMode renderMode;
+    SDL_Texture *framebufferTexture;
+    std::vector<Uint32> framebuffer;    // ARGB8888 pixels drawn this frame
+    std::vector<Uint32> uploadedFrame;  // What framebufferTexture currently holds
+
+    CachedText pathLabel;
+    CachedText helpText;
+    std::vector<CachedRow> rowCache;    // Indexed by item index modulo its size
+    int rowTextWidth;                   // Largest label drawn in a cell
+    int rowTextHeight;
+    bool rowTexturesPooled;             // Each row slot owns a texture that labels are uploaded into
+    Uint32 rowCacheMisses;              // Visible rows rasterized on the render thread because the worker had not delivered them
+
+    TextRasterizer *rowRasterizer;      // nullptr when rows are rasterized on the render thread
+    std::vector<TextRasterizer::Job> stagedJobs;
+    std::vector<TextRasterizer::Result> readyRows;
+    size_t readyRowsConsumed;
+    int prefetchFirst;                  // Item range the last prefetch covered
+    int prefetchLast;
+    int lastScrollOffset;
+    Uint32 lastListingGeneration;
+    int scrollDirection;                // 1 when scrolling down the list, -1 when scrolling up
+
+    bool initFramebuffer();
+    void uploadDirtyRows();
+    void blitSurface(const SDL_Surface *source, int x, int y, int w, int h);
+
+    void releaseText(CachedText &entry);
+    SDL_Surface *renderTextSurface(const std::string &text, SDL_Color color);
+    void rasterizeText(CachedText &entry, SDL_Color color);
+    void adoptSurface(CachedText &entry, SDL_Surface *surface);
+    void adoptRowSurface(CachedRow &row, SDL_Surface *surface);
+    void resizeRowCache(size_t size);
+
+    void queueRowJob(const std::vector<FileItem> &items, Uint32 listingGeneration, int itemIndex);
+    void scheduleRowPrefetch(const std::vector<FileItem> &items, Uint32 listingGeneration, int scrollOffset, int visibleItemsCount);
+    void uploadReadyRows(Uint32 listingGeneration, Uint64 deadline);
+    bool rasterizeMissingRows(const std::vector<FileItem> &items, Uint32 listingGeneration, int scrollOffset, int visibleItemsCount, Uint64 deadline);
+
+    void fillRect(const SDL_Rect &rect, SDL_Color color);
+    void drawRect(const SDL_Rect &rect, SDL_Color color);
+    void drawText(const CachedText &entry, int x, int y);
     void drawThickRect(const SDL_Rect &rect, int thickness, SDL_Color color);
     void drawHorizontalLine(int y, int thickness, SDL_Color color, int startX, int endX);
 };
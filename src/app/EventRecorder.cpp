@@ -0,0 +1,108 @@
+#include "app/EventRecorder.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+static const char *EVENT_LOG_HEADER = "# SDLFileBrowser event log v1";
+
+EventRecorder::EventRecorder() : firstTimestamp(0)
+{
+}
+
+void EventRecorder::record(const SDL_Event &e)
+{
+    if (e.type != SDL_KEYDOWN && e.type != SDL_CONTROLLERBUTTONDOWN && e.type != SDL_QUIT)
+    {
+        return;
+    }
+
+    if (events.empty())
+    {
+        firstTimestamp = e.common.timestamp;
+    }
+
+    SDL_Event copy = e;
+    copy.common.timestamp = e.common.timestamp - firstTimestamp;
+    events.push_back(copy);
+}
+
+void EventRecorder::clear()
+{
+    events.clear();
+    firstTimestamp = 0;
+}
+
+bool EventRecorder::save(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "EventRecorder: Could not open " << path << " for writing." << std::endl;
+        return false;
+    }
+
+    out << EVENT_LOG_HEADER << "\n";
+    for (const SDL_Event &e : events)
+    {
+        int code = 0;
+        if (e.type == SDL_KEYDOWN)
+        {
+            code = e.key.keysym.sym;
+        }
+        else if (e.type == SDL_CONTROLLERBUTTONDOWN)
+        {
+            code = e.cbutton.button;
+        }
+        out << e.common.timestamp << " " << e.type << " " << code << "\n";
+    }
+    return (bool)out;
+}
+
+bool EventRecorder::load(const std::string &path, std::vector<SDL_Event> &events)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "EventRecorder: Could not open " << path << std::endl;
+        return false;
+    }
+
+    events.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        Uint32 timestamp, type;
+        int code;
+        if (!(fields >> timestamp >> type >> code))
+        {
+            std::cerr << "EventRecorder: Malformed line " << lineNumber << " in " << path << std::endl;
+            return false;
+        }
+
+        SDL_Event e;
+        std::memset(&e, 0, sizeof(e));
+        e.type = type;
+        e.common.timestamp = timestamp;
+        if (type == SDL_KEYDOWN)
+        {
+            e.key.state = SDL_PRESSED;
+            e.key.keysym.sym = code;
+        }
+        else if (type == SDL_CONTROLLERBUTTONDOWN)
+        {
+            e.cbutton.state = SDL_PRESSED;
+            e.cbutton.button = (Uint8)code;
+        }
+        events.push_back(e);
+    }
+    return true;
+}
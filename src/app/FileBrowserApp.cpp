@@ -1,19 +1,31 @@
 #include "app/FileBrowserApp.h"
 #include <iostream>
 #include <utility>
+#include <algorithm>
+#include <ctime>
 
 // UI constants from UIManager.cpp, necessary for calculating visible items
 extern const int HIGHLIGHT_BORDER_THICKNESS;
 extern const int LINE_HEIGHT;
 
+const std::string HELP_TEXT = "Keys: Arrows/Enter/Bksp/Tab/B/Esc | Pad: DPad/A/B/Y/X/Start";
+const char *JUMP_LIST_FILE = "jumplist.bin";
+
+// Used when the display does not report its refresh rate
+const int DEFAULT_REFRESH_RATE = 60;
+
 Uint32 FileBrowserApp::getRequiredSDLInitFlags()
 {
     return SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER | SDL_INIT_HAPTIC;
 }
 
 FileBrowserApp::FileBrowserApp()
-    : uiManager(nullptr), fileBrowser(nullptr), running(false),
-      m_currentDialogResult(DialogResult::None), m_selectedFilePath("")
+    : uiManager(nullptr), fileBrowser(nullptr), running(false), m_renderMode(UIManager::RenderMode::Auto),
+      m_eventRecorder(nullptr),
+      m_currentDialogResult(DialogResult::None), m_selectedFilePath(""),
+      m_frameStats{0, 0, 0.0, 0, DEFAULT_REFRESH_RATE, false, 0},
+      m_frameIntervalTicks(0), m_inputPending(false), m_pendingInputTimestamp(0),
+      m_jumpListPathSet(false), m_jumpCursor(0)
 {
 }
 
@@ -32,6 +44,10 @@ void FileBrowserApp::closeGameControllers()
 FileBrowserApp::~FileBrowserApp()
 {
     closeGameControllers();
+    if (!m_jumpListPath.empty() && m_jumpList.isDirty())
+    {
+        m_jumpList.save(m_jumpListPath);
+    }
     if (fileBrowser)
     {
         delete fileBrowser;
@@ -50,13 +66,33 @@ bool FileBrowserApp::init(SDL_Window *window, SDL_Renderer *renderer, const std:
     SDL_GetWindowSize(window, &screenWidth, &screenHeight);
 
     uiManager = new UIManager(window, renderer, screenWidth, screenHeight, fontPath, fontSize);
+    uiManager->setRenderMode(m_renderMode);
     if (!uiManager->init())
     {
         std::cerr << "FileBrowserApp: Failed to initialize UI Manager!" << std::endl;
         return false;
     }
 
-    fileBrowser = new FileBrowser();
+    fileBrowser = new FileBrowser(m_fileFilter);
+
+    if (!m_jumpListPathSet)
+    {
+        char *prefPath = SDL_GetPrefPath("hito16", "SDLFileBrowser");
+        if (prefPath)
+        {
+            m_jumpListPath = std::string(prefPath) + JUMP_LIST_FILE;
+            SDL_free(prefPath);
+        }
+        else
+        {
+            std::cerr << "FileBrowserApp: No preferences directory, jump list will not persist: " << SDL_GetError() << std::endl;
+        }
+    }
+    if (!m_jumpListPath.empty())
+    {
+        m_jumpList.load(m_jumpListPath);
+    }
+    m_jumpTargets.clear();
 
     const int PADDING_Y = 20;
 
@@ -67,6 +103,8 @@ bool FileBrowserApp::init(SDL_Window *window, SDL_Renderer *renderer, const std:
     int visibleItems = listRenderHeight / LINE_HEIGHT;
     fileBrowser->setVisibleItemsCount(visibleItems);
 
+    configureFramePacing(window, renderer);
+
     running = true;
     m_currentDialogResult = DialogResult::None;
     m_selectedFilePath = "";
@@ -99,6 +137,42 @@ bool FileBrowserApp::init(SDL_Window *window, SDL_Renderer *renderer, const std:
     return true;
 }
 
+void FileBrowserApp::configureFramePacing(SDL_Window *window, SDL_Renderer *renderer)
+{
+    m_frameStats = {0, 0, 0.0, 0, DEFAULT_REFRESH_RATE, false, 0};
+    m_inputPending = false;
+
+    SDL_DisplayMode mode;
+    int displayIndex = SDL_GetWindowDisplayIndex(window);
+    if (displayIndex >= 0 && SDL_GetCurrentDisplayMode(displayIndex, &mode) == 0 && mode.refresh_rate > 0)
+    {
+        m_frameStats.refreshRate = mode.refresh_rate;
+    }
+
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0)
+    {
+        m_frameStats.vsync = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    }
+
+    m_frameIntervalTicks = SDL_GetPerformanceFrequency() / m_frameStats.refreshRate;
+}
+
+void FileBrowserApp::recordPresentLatency()
+{
+    if (!m_inputPending)
+    {
+        return;
+    }
+    m_inputPending = false;
+
+    Uint32 latency = SDL_GetTicks() - m_pendingInputTimestamp;
+    m_frameStats.lastInputLatencyMs = latency;
+    m_frameStats.maxInputLatencyMs = std::max(m_frameStats.maxInputLatencyMs, latency);
+    m_frameStats.latencySamples++;
+    m_frameStats.averageInputLatencyMs += (latency - m_frameStats.averageInputLatencyMs) / m_frameStats.latencySamples;
+}
+
 void FileBrowserApp::updateAndRender()
 {
     if (!running || !uiManager || !fileBrowser)
@@ -109,24 +183,23 @@ void FileBrowserApp::updateAndRender()
     uiManager->clearRenderer();
     uiManager->drawCurrentPath(fileBrowser->getCurrentPath());
     uiManager->drawFileList(fileBrowser->getCurrentItems(),
+                            fileBrowser->getListingGeneration(),
                             fileBrowser->getSelectedIndex(),
                             fileBrowser->getScrollOffset(),
                             fileBrowser->getVisibleItemsCount());
     uiManager->drawScrollbar(fileBrowser->getCurrentItems().size(),
                              fileBrowser->getVisibleItemsCount(),
                              fileBrowser->getScrollOffset());
-    uiManager->drawHelpText("Keyboard: Arrows/Enter/Bksp/Esc | Controller: DPad/A/B/Start", fileBrowser->getVisibleItemsCount());
+    uiManager->drawHelpText(HELP_TEXT, fileBrowser->getVisibleItemsCount());
     uiManager->presentRenderer();
+    m_frameStats.rowCacheMisses = uiManager->getRowCacheMisses();
+    recordPresentLatency();
 }
 
-void FileBrowserApp::handleInput(SDL_Event &e)
+FileBrowserApp::Action FileBrowserApp::actionForEvent(const SDL_Event &e)
 {
-    if (!running)
-        return;
-
     Action action = Action::None; // Default action
 
-    // Step 2: Map SDL events to our custom Action enum
     switch (e.type)
     {
     case SDL_KEYDOWN:
@@ -136,6 +209,8 @@ void FileBrowserApp::handleInput(SDL_Event &e)
                 case SDLK_DOWN:     action = Action::NavigateDown; break;
                 case SDLK_BACKSPACE:action = Action::NavigateParent; break;
                 case SDLK_RETURN:   action = Action::SelectConfirm; break;
+                case SDLK_TAB:      action = Action::JumpToRecent; break;
+                case SDLK_b:        action = Action::ToggleBookmark; break;
                 case SDLK_ESCAPE:   action = Action::Cancel; break;
                 default: break;
             }
@@ -149,6 +224,8 @@ void FileBrowserApp::handleInput(SDL_Event &e)
                 case SDL_CONTROLLER_BUTTON_DPAD_DOWN: action = Action::NavigateDown; break;
                 case SDL_CONTROLLER_BUTTON_B:         action = Action::NavigateParent; break; // B for Back
                 case SDL_CONTROLLER_BUTTON_A:         action = Action::SelectConfirm; break;
+                case SDL_CONTROLLER_BUTTON_Y:         action = Action::JumpToRecent; break;
+                case SDL_CONTROLLER_BUTTON_X:         action = Action::ToggleBookmark; break;
                 case SDL_CONTROLLER_BUTTON_START:     action = Action::Cancel; break; // Start to cancel/quit
                 default: break;
             }
@@ -158,7 +235,27 @@ void FileBrowserApp::handleInput(SDL_Event &e)
     case SDL_QUIT:
         action = Action::QuitApp;
         break;
+    }
+
+    return action;
+}
+
+void FileBrowserApp::handleInput(SDL_Event &e)
+{
+    if (!running)
+        return;
+
+    if (m_eventRecorder)
+    {
+        m_eventRecorder->record(e);
+    }
+
+    // Step 2: Map SDL events to our custom Action enum
+    Action action = actionForEvent(e);
 
+    // Controller hotplug is handled here rather than mapped to an action
+    switch (e.type)
+    {
     case SDL_CONTROLLERDEVICEADDED:
     {
         SDL_GameController *c = SDL_GameControllerOpen(e.cdevice.which);
@@ -193,6 +290,22 @@ void FileBrowserApp::handleInput(SDL_Event &e)
     break;
     }
 
+    // Latency is measured from the oldest input not yet shown on screen
+    if (action != Action::None && !m_inputPending)
+    {
+        m_inputPending = true;
+        m_pendingInputTimestamp = e.common.timestamp ? e.common.timestamp : SDL_GetTicks();
+    }
+
+    // Any other input settles on the directory the jump button reached
+    bool currentVisitRecorded = false;
+    if (action != Action::None && action != Action::JumpToRecent)
+    {
+        currentVisitRecorded = finishJumpCycle();
+    }
+    // Only a listing that was actually rebuilt counts as a visit, going up at the root does nothing
+    unsigned int listingGeneration = fileBrowser->getListingGeneration();
+
     // Step 3: Execute the determined action
     switch (action)
     {
@@ -204,7 +317,18 @@ void FileBrowserApp::handleInput(SDL_Event &e)
         break;
     case Action::NavigateParent:
         fileBrowser->goUpDirectory();
+        if (fileBrowser->getListingGeneration() != listingGeneration)
+            m_jumpList.recordVisit(fileBrowser->getCurrentPath(), std::time(nullptr));
+        break;
+    case Action::JumpToRecent:
+        jumpToNextTarget();
         break;
+    case Action::ToggleBookmark:
+    {
+        bool bookmarked = m_jumpList.toggleBookmark(fileBrowser->getCurrentPath(), std::time(nullptr));
+        std::cout << (bookmarked ? "Bookmarked: " : "Removed bookmark: ") << fileBrowser->getCurrentPath() << std::endl;
+    }
+    break;
     case Action::SelectConfirm:
     {
         if (fileBrowser->getCurrentItems().empty())
@@ -214,12 +338,16 @@ void FileBrowserApp::handleInput(SDL_Event &e)
         if (!selectedItem.isDirectory)
         {
             m_selectedFilePath = fileBrowser->getCurrentPath() + "/" + selectedItem.name;
+            if (!currentVisitRecorded)
+                m_jumpList.recordVisit(fileBrowser->getCurrentPath(), std::time(nullptr));
             m_currentDialogResult = DialogResult::FileSelected;
             running = false; // Exit the loop
         }
         else
         {
             fileBrowser->tryOpenSelectedItem(); // Open directory
+            if (fileBrowser->getListingGeneration() != listingGeneration)
+                m_jumpList.recordVisit(fileBrowser->getCurrentPath(), std::time(nullptr));
         }
     }
     break;
@@ -237,26 +365,92 @@ void FileBrowserApp::handleInput(SDL_Event &e)
     }
 }
 
+// The first press snapshots the ranking, later presses walk down it. Visits are only recorded
+// once the user stops on a directory, so cycling does not reorder the list under them.
+void FileBrowserApp::jumpToNextTarget()
+{
+    if (m_jumpTargets.empty())
+    {
+        std::vector<std::string> ranked = m_jumpList.rankedPaths(std::time(nullptr));
+        for (std::string &path : ranked)
+        {
+            if (path != fileBrowser->getCurrentPath())
+            {
+                m_jumpTargets.push_back(std::move(path));
+            }
+        }
+        m_jumpCursor = 0;
+        if (m_jumpTargets.empty())
+        {
+            std::cout << "No recent or bookmarked directories yet." << std::endl;
+            return;
+        }
+    }
+
+    // Skip targets that have since been removed
+    for (size_t attempts = 0; attempts < m_jumpTargets.size(); ++attempts)
+    {
+        const std::string &target = m_jumpTargets[m_jumpCursor];
+        m_jumpCursor = (m_jumpCursor + 1) % m_jumpTargets.size();
+        if (fileBrowser->navigateTo(target))
+        {
+            return;
+        }
+    }
+}
+
+bool FileBrowserApp::finishJumpCycle()
+{
+    if (m_jumpTargets.empty())
+    {
+        return false;
+    }
+    m_jumpTargets.clear();
+    m_jumpList.recordVisit(fileBrowser->getCurrentPath(), std::time(nullptr));
+    return true;
+}
+
 FileBrowserApp::DialogResult FileBrowserApp::runStandaloneLoop()
 {
     SDL_Event e;
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
     while (running)
     {
+        Uint64 frameStart = SDL_GetPerformanceCounter();
         while (SDL_PollEvent(&e) != 0)
         {
             handleInput(e);
         }
         updateAndRender();
-        SDL_Delay(16);
+
+        // With vsync the present normally waited for the display, sleeping again would add a frame of latency.
+        // The vsync flag only means it was requested though: a hidden or minimized window, or a driver that
+        // forces it off, returns from present at once. A frame shorter than half an interval did not block,
+        // so sleep for what is left of the interval then too rather than spin.
+        Uint64 elapsed = SDL_GetPerformanceCounter() - frameStart;
+        bool presentBlocked = m_frameStats.vsync && elapsed >= m_frameIntervalTicks / 2;
+        if (!presentBlocked)
+        {
+            if (elapsed < m_frameIntervalTicks)
+            {
+                Uint32 remainingMs = (Uint32)((m_frameIntervalTicks - elapsed) * 1000 / frequency);
+                if (remainingMs > 0)
+                {
+                    SDL_Delay(remainingMs);
+                }
+            }
+        }
     }
     return m_currentDialogResult;
 }
 
 std::string FileBrowserApp::showFileSelectionDialog(SDL_Window *window, SDL_Renderer *renderer,
                                                     int screenWidth, int screenHeight,
-                                                    const std::string &fontPath, int fontSize)
+                                                    const std::string &fontPath, int fontSize,
+                                                    const FileFilter &filter)
 {
     FileBrowserApp modalApp;
+    modalApp.setFileFilter(filter);
 
     if (!modalApp.init(window, renderer, fontPath, fontSize))
     {
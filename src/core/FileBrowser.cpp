@@ -1,17 +1,139 @@
 #include "core/FileBrowser.h"
 #include <iostream>
 #include <algorithm> 
-
-FileBrowser::FileBrowser()
-    : selectedIndex(0), scrollOffset(0), visibleItemsCount(0) {
+#include <chrono>
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// Most recently left directories kept in listingCache()
+static const size_t LISTING_CACHE_ENTRIES = 8;
+
+// Coarsest directory mtime resolution we expect (FAT/exFAT store 2 s). A scan that started within this
+// long of the mtime may have missed an entry created in the same tick, so its listing is not reused.
+static const std::filesystem::file_time_type::duration MTIME_GRANULARITY = std::chrono::seconds(2);
+
+FileBrowser::FileBrowser(const FileFilter& filter)
+    : listingGeneration(0), selectedIndex(0), scrollOffset(0), visibleItemsCount(0), filter(filter) {
     currentPath = std::filesystem::current_path();
     listDirectory(currentPath);
 }
 
+std::list<FileBrowser::CachedListing>& FileBrowser::listingCache() {
+    static std::list<CachedListing> cache;
+    return cache;
+}
+
+// Moves the listing being left into the front of the cache, no copy of the items is made.
+// Listings built with a predicate are dropped, there is no way to tell whether another predicate agrees.
+void FileBrowser::stashCurrentListing() {
+    if (!currentPathString.empty() && !filter.hasPredicate()) {
+        std::list<CachedListing>& cache = listingCache();
+        cache.remove_if([this](const CachedListing& listing) {
+            return listing.path == currentPathString && listing.filterSignature == filter.getSignature();
+        });
+        cache.push_front({currentPathString, filter.getSignature(), currentWriteTime, currentScanTime, std::move(currentItems)});
+        if (cache.size() > LISTING_CACHE_ENTRIES) {
+            cache.pop_back();
+        }
+    }
+    currentItems.clear();
+    currentPathString.clear();
+}
+
+bool FileBrowser::takeCachedListing(const std::string& path, std::filesystem::file_time_type writeTime) {
+    if (filter.hasPredicate()) return false;
+
+    std::list<CachedListing>& cache = listingCache();
+    auto it = std::find_if(cache.begin(), cache.end(), [&](const CachedListing& listing) {
+        return listing.path == path && listing.filterSignature == filter.getSignature();
+    });
+    if (it == cache.end()) return false;
+
+    bool valid = it->writeTime == writeTime && it->scanTime - it->writeTime >= MTIME_GRANULARITY;
+    if (valid) {
+        currentItems = std::move(it->items);
+        currentScanTime = it->scanTime;
+    }
+    cache.erase(it);
+    return valid;
+}
+
+// Appends the entries of path that filter accepts to items. The filter sees the name before a
+// FileItem is built, so a rejected entry never takes a place in the sort.
+#ifdef _WIN32
+static void readFilteredEntries(const std::filesystem::path& path, const FileFilter& filter, std::vector<FileItem>& items) {
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        // native() is a wide string here, take the converted copy
+        const std::string name = entry.path().filename().string();
+        std::error_code typeError;
+        bool isDirectory = entry.is_directory(typeError);
+
+        if (!isDirectory && !filter.acceptsName(name)) continue;
+        if (!filter.acceptsEntry(entry)) continue;
+
+        items.push_back({name, isDirectory});
+    }
+}
+#else
+// readdir() hands out names in the DIR's own buffer, so a rejected entry costs no allocation. The type
+// comes from d_type; only entries it cannot settle (unknown, or a symlink that may lead to a directory)
+// are stat'ed, and a directory_entry is built only for a predicate.
+static void readFilteredEntries(const std::filesystem::path& path, const FileFilter& filter, std::vector<FileItem>& items) {
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        std::cerr << "Filesystem error: cannot open " << path.native() << ": " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    while (true) {
+        errno = 0;
+        const dirent* entry = readdir(dir);
+        if (!entry) {
+            if (errno != 0) {
+                std::cerr << "Filesystem error: cannot read " << path.native() << ": " << std::strerror(errno) << std::endl;
+            }
+            break;
+        }
+        std::string_view name(entry->d_name);
+        if (name == "." || name == "..") continue;
+
+        bool isDirectory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+            struct stat info;
+            isDirectory = fstatat(dirfd(dir), entry->d_name, &info, 0) == 0 && S_ISDIR(info.st_mode);
+        }
+
+        if (!isDirectory && !filter.acceptsName(name)) continue;
+        if (filter.hasPredicate()) {
+            std::error_code ec;
+            if (!filter.acceptsEntry(std::filesystem::directory_entry(path / name, ec))) continue;
+        }
+
+        items.push_back({std::string(name), isDirectory});
+    }
+    closedir(dir);
+}
+#endif
+
 void FileBrowser::listDirectory(const std::filesystem::path& path) {
+    stashCurrentListing();
     currentItems.clear();
     selectedIndex = 0;
     scrollOffset = 0;
+    currentPathString = path.string();
+    listingGeneration++;
+
+    std::error_code ec;
+    currentWriteTime = std::filesystem::last_write_time(path, ec);
+    if (!ec && takeCachedListing(currentPathString, currentWriteTime)) {
+        return;
+    }
+    // Taken before reading, anything that changes the directory after this has a later mtime
+    currentScanTime = std::filesystem::file_time_type::clock::now();
 
     try {
         std::vector<FileItem> tempItems; // Use a temporary vector for sorting
@@ -21,13 +143,7 @@ void FileBrowser::listDirectory(const std::filesystem::path& path) {
             tempItems.push_back({"..", true}); // ".." is always a directory
         }
 
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            tempItems.push_back({
-                entry.path().filename().string(),
-                std::filesystem::is_directory(entry.path())
-            });
-        }
-        
+        readFilteredEntries(path, filter, tempItems);
 
         std::sort(tempItems.begin(), tempItems.end(), [](const FileItem& a, const FileItem& b) {
             // Special handling for ".." to always be at the top
@@ -42,7 +158,7 @@ void FileBrowser::listDirectory(const std::filesystem::path& path) {
             return a.name < b.name;
         });
 
-        currentItems = tempItems; // Assign the sorted temporary vector
+        currentItems = std::move(tempItems); // Take over the sorted temporary vector
 
     } catch (const std::filesystem::filesystem_error& e) {
         std::cerr << "Filesystem error: " << e.what() << std::endl;
@@ -102,6 +218,27 @@ void FileBrowser::goUpDirectory() {
     }
 }
 
+void FileBrowser::clearListingCache() {
+    listingCache().clear();
+}
+
+void FileBrowser::setFilter(const FileFilter& newFilter) {
+    stashCurrentListing(); // Cached under the old filter
+    filter = newFilter;
+    listDirectory(currentPath);
+}
+
+bool FileBrowser::navigateTo(const std::filesystem::path& path) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(path, ec)) {
+        std::cerr << "Cannot open directory: " << path.string() << std::endl;
+        return false;
+    }
+    currentPath = path;
+    listDirectory(currentPath);
+    return true;
+}
+
 void FileBrowser::setVisibleItemsCount(int count) {
     visibleItemsCount = count;
 }
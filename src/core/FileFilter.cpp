@@ -0,0 +1,150 @@
+#include "core/FileFilter.h"
+#include <algorithm>
+#include <cctype>
+
+static inline unsigned char toLower(char c) {
+    return (unsigned char)std::tolower((unsigned char)c);
+}
+
+FileFilter::FileFilter() : maxExtensionLength(0) {
+}
+
+// FNV-1a over the lower cased bytes, so lookups need no temporary string
+uint64_t FileFilter::hashLowerCase(std::string_view text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : text) {
+        hash ^= toLower(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+FileFilter& FileFilter::addExtension(std::string_view extension) {
+    if (!extension.empty() && extension.front() == '.') {
+        extension.remove_prefix(1);
+    }
+    if (extension.empty()) return *this;
+
+    std::string lower(extension.size(), '\0');
+    std::transform(extension.begin(), extension.end(), lower.begin(), toLower);
+    if (std::find(extensions.begin(), extensions.end(), lower) != extensions.end()) return *this;
+
+    extensionHashes.insert(hashLowerCase(lower));
+    maxExtensionLength = std::max(maxExtensionLength, lower.size());
+    signature += "e:" + lower + "\n";
+    extensions.push_back(std::move(lower));
+    return *this;
+}
+
+FileFilter& FileFilter::addGlob(std::string_view pattern) {
+    globs.push_back(compileGlob(pattern));
+    signature += "g:";
+    signature += pattern;
+    signature += "\n";
+    return *this;
+}
+
+FileFilter& FileFilter::setPredicate(Predicate predicate) {
+    this->predicate = std::move(predicate);
+    return *this;
+}
+
+// Turns the pattern into tokens once, so matching never re-parses classes or escapes.
+// An unterminated '[' is taken literally, as shells do.
+std::vector<FileFilter::GlobToken> FileFilter::compileGlob(std::string_view pattern) {
+    std::vector<GlobToken> tokens;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '*') {
+            if (tokens.empty() || tokens.back().kind != GlobToken::Kind::AnyRun) {
+                tokens.push_back({GlobToken::Kind::AnyRun, 0, {}});
+            }
+        } else if (c == '?') {
+            tokens.push_back({GlobToken::Kind::AnyChar, 0, {}});
+        } else if (c == '[' && pattern.find(']', i + 2) != std::string_view::npos) {
+            GlobToken token{GlobToken::Kind::Class, 0, {}};
+            size_t j = i + 1;
+            bool negate = pattern[j] == '!' || pattern[j] == '^';
+            if (negate) ++j;
+            // A ']' right after the opening bracket is a member, not the end
+            size_t first = j;
+            for (; j < pattern.size() && (pattern[j] != ']' || j == first); ++j) {
+                unsigned char low = (unsigned char)pattern[j];
+                if (j + 2 < pattern.size() && pattern[j + 1] == '-' && pattern[j + 2] != ']') {
+                    unsigned char high = (unsigned char)pattern[j + 2];
+                    for (unsigned int ch = low; ch <= high; ++ch) token.chars.set(ch);
+                    j += 2;
+                } else {
+                    token.chars.set(low);
+                }
+            }
+            if (j >= pattern.size()) {
+                tokens.push_back({GlobToken::Kind::Literal, c, {}});
+                continue;
+            }
+            if (negate) token.chars.flip();
+            tokens.push_back(token);
+            i = j;
+        } else {
+            tokens.push_back({GlobToken::Kind::Literal, c, {}});
+        }
+    }
+    return tokens;
+}
+
+// Linear scan that backtracks only to the most recent '*', so it never goes exponential
+bool FileFilter::matchesGlob(const std::vector<GlobToken>& glob, std::string_view name) {
+    size_t t = 0, n = 0;
+    size_t starToken = std::string_view::npos, starName = 0;
+    while (n < name.size()) {
+        if (t < glob.size()) {
+            const GlobToken& token = glob[t];
+            unsigned char c = (unsigned char)name[n];
+            if (token.kind == GlobToken::Kind::AnyRun) {
+                starToken = t++;
+                starName = n;
+                continue;
+            }
+            bool matched = token.kind == GlobToken::Kind::AnyChar ||
+                           (token.kind == GlobToken::Kind::Literal && (unsigned char)token.literal == c) ||
+                           (token.kind == GlobToken::Kind::Class && token.chars.test(c));
+            if (matched) {
+                ++t;
+                ++n;
+                continue;
+            }
+        }
+        if (starToken == std::string_view::npos) return false;
+        t = starToken + 1;
+        n = ++starName;
+    }
+    while (t < glob.size() && glob[t].kind == GlobToken::Kind::AnyRun) ++t;
+    return t == glob.size();
+}
+
+bool FileFilter::matchesExtension(std::string_view name) const {
+    size_t dot = name.rfind('.');
+    if (dot == std::string_view::npos || dot == 0) return false; // No extension, or a dot file
+    std::string_view extension = name.substr(dot + 1);
+    if (extension.empty() || extension.size() > maxExtensionLength) return false;
+
+    if (extensionHashes.find(hashLowerCase(extension)) == extensionHashes.end()) return false;
+    // Confirm the hash hit
+    for (const std::string& candidate : extensions) {
+        if (candidate.size() == extension.size() &&
+            std::equal(candidate.begin(), candidate.end(), extension.begin(),
+                       [](char a, char b) { return (unsigned char)a == toLower(b); })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FileFilter::acceptsName(std::string_view name) const {
+    if (extensions.empty() && globs.empty()) return true;
+    if (matchesExtension(name)) return true;
+    for (const std::vector<GlobToken>& glob : globs) {
+        if (matchesGlob(glob, name)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,216 @@
+#include "core/JumpList.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+
+// File layout, all integers little endian:
+//   "SFBJ" | u8 version | u32 entry count
+//   per entry: u32 visit count | i64 last visit | u8 flags | u16 path length | path bytes
+static const char JUMP_LIST_MAGIC[4] = {'S', 'F', 'B', 'J'};
+static const uint8_t JUMP_LIST_VERSION = 1;
+static const uint8_t FLAG_BOOKMARKED = 0x01;
+
+static const size_t MAX_ENTRIES = 64;
+// Once all visit counts add up to more than this, every count is scaled down by 9/10 (z and zoxide
+// age their databases the same way), so directories nobody returns to lose their rank
+static const uint64_t MAX_TOTAL_VISITS = 1000;
+
+static const int64_t HOUR = 60 * 60;
+static const int64_t DAY = 24 * HOUR;
+static const int64_t WEEK = 7 * DAY;
+
+static void putBytes(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back((char)((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static bool getBytes(const std::string& in, size_t& offset, int bytes, uint64_t& value) {
+    if (in.size() - offset < (size_t)bytes) return false;
+    value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= (uint64_t)(uint8_t)in[offset + i] << (8 * i);
+    }
+    offset += bytes;
+    return true;
+}
+
+JumpList::JumpList() : dirty(false) {
+}
+
+bool JumpList::load(const std::string& filePath) {
+    entries.clear();
+    dirty = false;
+
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false; // No jump list yet
+    }
+
+    // Whole file in one read, then parse from memory
+    std::string data((size_t)file.tellg(), '\0');
+    file.seekg(0);
+    if (!file.read(&data[0], data.size())) {
+        std::cerr << "JumpList: Could not read " << filePath << std::endl;
+        return false;
+    }
+
+    size_t offset = sizeof(JUMP_LIST_MAGIC);
+    uint64_t version, count;
+    if (data.size() < offset || !std::equal(JUMP_LIST_MAGIC, JUMP_LIST_MAGIC + sizeof(JUMP_LIST_MAGIC), data.begin()) ||
+        !getBytes(data, offset, 1, version) || version != JUMP_LIST_VERSION ||
+        !getBytes(data, offset, 4, count)) {
+        std::cerr << "JumpList: Ignoring unrecognised file " << filePath << std::endl;
+        return false;
+    }
+
+    entries.reserve(std::min<uint64_t>(count, MAX_ENTRIES));
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t visits, lastVisit, flags, length;
+        if (!getBytes(data, offset, 4, visits) || !getBytes(data, offset, 8, lastVisit) ||
+            !getBytes(data, offset, 1, flags) || !getBytes(data, offset, 2, length) ||
+            data.size() - offset < length) {
+            std::cerr << "JumpList: Truncated file " << filePath << std::endl;
+            entries.clear();
+            return false;
+        }
+        entries.push_back({data.substr(offset, length), (uint32_t)visits, (int64_t)lastVisit,
+                           (flags & FLAG_BOOKMARKED) != 0});
+        offset += length;
+    }
+    return true;
+}
+
+bool JumpList::save(const std::string& filePath) const {
+    std::string data(JUMP_LIST_MAGIC, sizeof(JUMP_LIST_MAGIC));
+    putBytes(data, JUMP_LIST_VERSION, 1);
+    putBytes(data, entries.size(), 4);
+    for (const JumpEntry& entry : entries) {
+        size_t length = std::min<size_t>(entry.path.size(), UINT16_MAX);
+        putBytes(data, entry.visitCount, 4);
+        putBytes(data, (uint64_t)entry.lastVisit, 8);
+        putBytes(data, entry.bookmarked ? FLAG_BOOKMARKED : 0, 1);
+        putBytes(data, length, 2);
+        data.append(entry.path, 0, length);
+    }
+
+    // Written beside the real file and renamed over it, so a crash or a full disk leaves the old list
+    std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(data.data(), data.size()) || !file.flush()) {
+            std::cerr << "JumpList: Could not write " << tempPath << std::endl;
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec) {
+        std::cerr << "JumpList: Could not replace " << filePath << ": " << ec.message() << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+JumpEntry& JumpList::findOrAdd(const std::string& directory, int64_t now) {
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&](const JumpEntry& entry) { return entry.path == directory; });
+    if (it != entries.end()) {
+        return *it;
+    }
+    entries.push_back({directory, 0, now, false});
+    return entries.back();
+}
+
+void JumpList::recordVisit(const std::string& directory, int64_t now) {
+    JumpEntry& entry = findOrAdd(directory, now);
+    entry.visitCount++;
+    entry.lastVisit = now;
+    dirty = true;
+    ageVisits(directory);
+    evictOverflow(now, directory);
+}
+
+bool JumpList::toggleBookmark(const std::string& directory, int64_t now) {
+    JumpEntry& entry = findOrAdd(directory, now);
+    entry.bookmarked = !entry.bookmarked;
+    bool bookmarked = entry.bookmarked;
+    dirty = true;
+    // A directory only ever bookmarked has nothing left to rank it by once unbookmarked
+    if (!bookmarked && entry.visitCount == 0) {
+        entries.erase(entries.begin() + (&entry - entries.data()));
+        return false;
+    }
+    evictOverflow(now, directory);
+    return bookmarked;
+}
+
+// Scales every visit count down once their total passes MAX_TOTAL_VISITS and drops the
+// directories that reach zero. keep, the directory just visited, stays with at least one visit.
+void JumpList::ageVisits(const std::string& keep) {
+    uint64_t total = 0;
+    for (const JumpEntry& entry : entries) {
+        total += entry.visitCount;
+    }
+    if (total <= MAX_TOTAL_VISITS) return;
+
+    for (JumpEntry& entry : entries) {
+        entry.visitCount = (uint32_t)((uint64_t)entry.visitCount * 9 / 10);
+        if (entry.path == keep) {
+            entry.visitCount = std::max<uint32_t>(entry.visitCount, 1);
+        }
+    }
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const JumpEntry& entry) { return !entry.bookmarked && entry.visitCount == 0; }),
+                  entries.end());
+}
+
+// Drops the lowest ranked non-bookmarked directory once the list is full. keep, the directory just
+// touched, is never the one dropped, or a new directory could not outrank a full list of old ones.
+void JumpList::evictOverflow(int64_t now, const std::string& keep) {
+    while (entries.size() > MAX_ENTRIES) {
+        auto worst = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->bookmarked || it->path == keep) continue;
+            if (worst == entries.end() || frecency(*it, now) < frecency(*worst, now)) {
+                worst = it;
+            }
+        }
+        if (worst == entries.end()) return; // Only bookmarks left
+        entries.erase(worst);
+    }
+}
+
+double JumpList::frecency(const JumpEntry& entry, int64_t now) {
+    int64_t age = now - entry.lastVisit;
+    double weight;
+    if (age < HOUR) weight = 4.0;
+    else if (age < DAY) weight = 2.0;
+    else if (age < WEEK) weight = 0.5;
+    else weight = 0.25;
+    return entry.visitCount * weight;
+}
+
+std::vector<std::string> JumpList::rankedPaths(int64_t now) const {
+    std::vector<const JumpEntry*> ranked;
+    ranked.reserve(entries.size());
+    for (const JumpEntry& entry : entries) {
+        ranked.push_back(&entry);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [now](const JumpEntry* a, const JumpEntry* b) {
+        if (a->bookmarked != b->bookmarked) return a->bookmarked;
+        return frecency(*a, now) > frecency(*b, now);
+    });
+
+    std::vector<std::string> paths;
+    paths.reserve(ranked.size());
+    for (const JumpEntry* entry : ranked) {
+        paths.push_back(entry->path);
+    }
+    return paths;
+}
@@ -0,0 +1,107 @@
+#include "core/TextRasterizer.h"
+#include <iostream>
+
+TextRasterizer::TextRasterizer(const std::string &fontPath, int fontSize, SDL_Color color)
+    : fontPath(fontPath), fontSize(fontSize), color(color), font(nullptr), maxJobs(0),
+      stopping(false), nextJob(0)
+{
+}
+
+TextRasterizer::~TextRasterizer()
+{
+    stop();
+}
+
+bool TextRasterizer::start(size_t maxJobs)
+{
+    // Opening here rather than on the worker keeps FT_Library use (face creation) on one thread
+    font = TTF_OpenFont(fontPath.c_str(), fontSize);
+    if (!font)
+    {
+        std::cerr << "TextRasterizer: TTF_OpenFont Error: " << TTF_GetError() << std::endl;
+        return false;
+    }
+
+    this->maxJobs = maxJobs;
+    pending.reserve(maxJobs);
+    results.reserve(maxJobs);
+    nextJob = 0;
+    stopping = false;
+    worker = std::thread(&TextRasterizer::run, this);
+    return true;
+}
+
+void TextRasterizer::stop()
+{
+    if (worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        worker.join();
+    }
+
+    for (Result &result : results)
+    {
+        SDL_FreeSurface(result.surface);
+    }
+    results.clear();
+    pending.clear();
+
+    if (font)
+    {
+        TTF_CloseFont(font);
+        font = nullptr;
+    }
+}
+
+void TextRasterizer::submit(std::vector<Job> &jobs)
+{
+    jobs.reserve(maxJobs);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(jobs);
+        nextJob = 0;
+    }
+    jobs.clear();
+    wakeup.notify_one();
+}
+
+void TextRasterizer::collectResults(std::vector<Result> &out)
+{
+    out.reserve(maxJobs);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.swap(out);
+    }
+    // Room was made for more results
+    wakeup.notify_one();
+}
+
+void TextRasterizer::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wakeup.wait(lock, [this]
+                    { return stopping || (nextJob < pending.size() && results.size() < maxJobs); });
+        if (stopping)
+        {
+            break;
+        }
+
+        Job job = pending[nextJob++];
+        lock.unlock();
+        SDL_Surface *surface = TTF_RenderUTF8_Blended(font, job.text, color);
+        lock.lock();
+
+        if (!surface)
+        {
+            std::cerr << "TextRasterizer: TTF_RenderUTF8_Blended Error: " << TTF_GetError() << std::endl;
+            continue;
+        }
+        results.push_back({job.listingGeneration, job.itemIndex, surface});
+    }
+}
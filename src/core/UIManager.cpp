@@ -1,13 +1,17 @@
 #include "core/UIManager.h"
 #include "core/FileBrowser.h"
+#include "core/TextRasterizer.h"
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 
 // --- UI Constants  ---
 const SDL_Color BLUE_BACKGROUND_BRIGHTER = {0x2C, 0x5D, 0x8A, 0xFF};
 const SDL_Color WHITE_COLOR = {255, 255, 255, 255};
 const SDL_Color HIGHLIGHT_BORDER_COLOR = {0x00, 0xA0, 0xFF, 0xFF};
 const SDL_Color DEFAULT_CELL_BORDER_COLOR = {255, 255, 255, 255};
+const SDL_Color SCROLLBAR_TRACK_COLOR = {0x40, 0x40, 0x40, 0xFF};
+const SDL_Color SCROLLBAR_THUMB_COLOR = {0x80, 0x80, 0x80, 0xFF};
 
 const int HIGHLIGHT_BORDER_THICKNESS = 3;
 const int CELL_SPACING = 5;
@@ -17,16 +21,59 @@ const int SCROLLBAR_WIDTH = 10;
 const int SCROLLBAR_MARGIN_RIGHT = 10;
 const int SCROLLBAR_TO_LINE_PADDING = 10;
 const int LEFT_MARGIN = 20;
+const int CELL_PADDING_X = 10;
+
+const char CURRENT_PATH_PREFIX[] = "Current Path: ";
+const size_t ROW_TEXT_RESERVE = 256; // Row label capacity reserved up front so reuse does not reallocate
+
+// The row cache holds three screens of rows: the visible one, a full screen ahead in the scroll
+// direction and half a screen behind it. The off-screen rows are prefetched by the TextRasterizer
+// worker; visible rows it has not delivered are rasterized on the render thread.
+const int ROW_CACHE_SCREENS = 3;
+const size_t MAX_PREFETCH_JOBS = 256;
+const Uint64 ROW_UPLOAD_BUDGET_US = 2000; // Time per frame spent on row labels: uploading worker surfaces and rasterizing missing rows
 
 UIManager::UIManager(SDL_Window *window, SDL_Renderer *renderer, int screenWidth, int screenHeight, const std::string &fontPath, int fontSize)
     : m_window(window), m_renderer(renderer), font(nullptr),
       screenWidth(screenWidth), screenHeight(screenHeight), fontSize(fontSize),
-      fontPath(fontPath)
+      fontPath(fontPath), renderMode(RenderMode::Auto), framebufferTexture(nullptr),
+      rowTextWidth(0), rowTextHeight(0), rowTexturesPooled(false), rowCacheMisses(0),
+      rowRasterizer(nullptr), readyRowsConsumed(0), prefetchFirst(0), prefetchLast(-1),
+      lastScrollOffset(-1), lastListingGeneration(0), scrollDirection(1)
+{
+}
+
+static inline Uint32 mapColor(SDL_Color color)
 {
+    return ((Uint32)color.a << 24) | ((Uint32)color.r << 16) | ((Uint32)color.g << 8) | (Uint32)color.b;
 }
 
 UIManager::~UIManager()
 {
+    if (rowRasterizer)
+    {
+        delete rowRasterizer;
+        rowRasterizer = nullptr;
+    }
+    for (size_t i = readyRowsConsumed; i < readyRows.size(); ++i)
+    {
+        SDL_FreeSurface(readyRows[i].surface);
+    }
+    readyRows.clear();
+
+    releaseText(pathLabel);
+    releaseText(helpText);
+    for (CachedRow &row : rowCache)
+    {
+        releaseText(row.text);
+    }
+
+    if (framebufferTexture)
+    {
+        SDL_DestroyTexture(framebufferTexture);
+        framebufferTexture = nullptr;
+    }
+
     if (font)
     {
         TTF_CloseFont(font);
@@ -51,23 +98,175 @@ bool UIManager::init()
         return false;
     }
 
+    // Framebuffer drawing has not been measured against the renderer path on a real software
+    // renderer yet (event_replay --compare-modes does that), so it stays opt-in until it has
+    if (renderMode == RenderMode::Auto)
+    {
+        renderMode = RenderMode::Renderer;
+    }
+
+    if (renderMode == RenderMode::Framebuffer && !initFramebuffer())
+    {
+        std::cerr << "UIManager: Falling back to renderer drawing." << std::endl;
+        renderMode = RenderMode::Renderer;
+    }
+
+    rowRasterizer = new TextRasterizer(fontPath, fontSize, WHITE_COLOR);
+    if (!rowRasterizer->start(MAX_PREFETCH_JOBS))
+    {
+        std::cerr << "UIManager: Rasterizing rows on the render thread." << std::endl;
+        delete rowRasterizer;
+        rowRasterizer = nullptr;
+    }
+    stagedJobs.reserve(MAX_PREFETCH_JOBS);
+    readyRows.reserve(MAX_PREFETCH_JOBS);
+
     return true;
 }
 
+bool UIManager::initFramebuffer()
+{
+    framebufferTexture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, screenWidth, screenHeight);
+    if (!framebufferTexture)
+    {
+        std::cerr << "SDL_CreateTexture Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(framebufferTexture, SDL_BLENDMODE_NONE);
+
+    framebuffer.assign((size_t)screenWidth * screenHeight, 0);
+    uploadedFrame.assign((size_t)screenWidth * screenHeight, 0);
+    SDL_UpdateTexture(framebufferTexture, NULL, uploadedFrame.data(), screenWidth * sizeof(Uint32));
+    return true;
+}
+
+// Compares the new frame against what the texture holds and uploads each run of changed rows once.
+// A selection move only touches two cells, so most frames upload a small fraction of the screen.
+void UIManager::uploadDirtyRows()
+{
+    const size_t rowBytes = (size_t)screenWidth * sizeof(Uint32);
+    int y = 0;
+    while (y < screenHeight)
+    {
+        if (std::memcmp(&framebuffer[(size_t)y * screenWidth], &uploadedFrame[(size_t)y * screenWidth], rowBytes) == 0)
+        {
+            ++y;
+            continue;
+        }
+
+        int firstRow = y;
+        while (y < screenHeight &&
+               std::memcmp(&framebuffer[(size_t)y * screenWidth], &uploadedFrame[(size_t)y * screenWidth], rowBytes) != 0)
+        {
+            ++y;
+        }
+
+        size_t offset = (size_t)firstRow * screenWidth;
+        std::memcpy(&uploadedFrame[offset], &framebuffer[offset], rowBytes * (y - firstRow));
+        SDL_Rect dirtyRect = {0, firstRow, screenWidth, y - firstRow};
+        SDL_UpdateTexture(framebufferTexture, &dirtyRect, &framebuffer[offset], (int)rowBytes);
+    }
+}
+
 void UIManager::clearRenderer()
 {
+    if (renderMode == RenderMode::Framebuffer)
+    {
+        std::fill(framebuffer.begin(), framebuffer.end(), mapColor(BLUE_BACKGROUND_BRIGHTER));
+        return;
+    }
     SDL_SetRenderDrawColor(m_renderer, BLUE_BACKGROUND_BRIGHTER.r, BLUE_BACKGROUND_BRIGHTER.g, BLUE_BACKGROUND_BRIGHTER.b, BLUE_BACKGROUND_BRIGHTER.a);
     SDL_RenderClear(m_renderer);
 }
 
 void UIManager::presentRenderer()
 {
+    if (renderMode == RenderMode::Framebuffer)
+    {
+        uploadDirtyRows();
+        SDL_RenderCopy(m_renderer, framebufferTexture, NULL, NULL);
+    }
     SDL_RenderPresent(m_renderer);
 }
 
+void UIManager::fillRect(const SDL_Rect &rect, SDL_Color color)
+{
+    if (renderMode != RenderMode::Framebuffer)
+    {
+        SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(m_renderer, &rect);
+        return;
+    }
+
+    int x0 = std::max(rect.x, 0);
+    int y0 = std::max(rect.y, 0);
+    int x1 = std::min(rect.x + rect.w, screenWidth);
+    int y1 = std::min(rect.y + rect.h, screenHeight);
+    if (x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+
+    Uint32 pixel = mapColor(color);
+    for (int y = y0; y < y1; ++y)
+    {
+        std::fill_n(&framebuffer[(size_t)y * screenWidth + x0], x1 - x0, pixel);
+    }
+}
+
+void UIManager::drawRect(const SDL_Rect &rect, SDL_Color color)
+{
+    if (renderMode != RenderMode::Framebuffer)
+    {
+        SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderDrawRect(m_renderer, &rect);
+        return;
+    }
+
+    // Same pixels as SDL_RenderDrawRect: a one pixel outline inside rect
+    fillRect({rect.x, rect.y, rect.w, 1}, color);
+    fillRect({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    fillRect({rect.x, rect.y + 1, 1, rect.h - 2}, color);
+    fillRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, color);
+}
+
+// Alpha blends the top left w x h of an ARGB8888 surface into the framebuffer
+void UIManager::blitSurface(const SDL_Surface *source, int x, int y, int w, int h)
+{
+    int srcX0 = std::max(0, -x);
+    int srcY0 = std::max(0, -y);
+    int srcX1 = std::min({source->w, w, screenWidth - x});
+    int srcY1 = std::min({source->h, h, screenHeight - y});
+
+    for (int sy = srcY0; sy < srcY1; ++sy)
+    {
+        const Uint32 *src = (const Uint32 *)((const Uint8 *)source->pixels + (size_t)sy * source->pitch);
+        Uint32 *dst = &framebuffer[(size_t)(y + sy) * screenWidth + x];
+        for (int sx = srcX0; sx < srcX1; ++sx)
+        {
+            Uint32 s = src[sx];
+            Uint32 a = s >> 24;
+            if (a == 0)
+            {
+                continue;
+            }
+            if (a == 0xFF)
+            {
+                dst[sx] = s;
+                continue;
+            }
+            Uint32 d = dst[sx];
+            Uint32 inv = 0xFF - a;
+            Uint32 r = (((s >> 16) & 0xFF) * a + ((d >> 16) & 0xFF) * inv) / 0xFF;
+            Uint32 g = (((s >> 8) & 0xFF) * a + ((d >> 8) & 0xFF) * inv) / 0xFF;
+            Uint32 b = ((s & 0xFF) * a + (d & 0xFF) * inv) / 0xFF;
+            dst[sx] = 0xFF000000 | (r << 16) | (g << 8) | b;
+        }
+    }
+}
+
 void UIManager::drawThickRect(const SDL_Rect &rect, int thickness, SDL_Color color)
 {
-    SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
     for (int i = 0; i < thickness; ++i)
     {
         SDL_Rect currentRect = {
@@ -75,12 +274,17 @@ void UIManager::drawThickRect(const SDL_Rect &rect, int thickness, SDL_Color col
             rect.y - i,
             rect.w + 2 * i,
             rect.h + 2 * i};
-        SDL_RenderDrawRect(m_renderer, &currentRect);
+        drawRect(currentRect, color);
     }
 }
 
 void UIManager::drawHorizontalLine(int y, int thickness, SDL_Color color, int startX, int endX)
 {
+    if (renderMode == RenderMode::Framebuffer)
+    {
+        fillRect({startX, y, endX - startX + 1, thickness}, color);
+        return;
+    }
     SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
     for (int i = 0; i < thickness; ++i)
     {
@@ -88,45 +292,383 @@ void UIManager::drawHorizontalLine(int y, int thickness, SDL_Color color, int st
     }
 }
 
-void UIManager::drawText(const std::string &text, int x, int y, SDL_Color color)
+void UIManager::releaseText(CachedText &entry)
 {
+    if (entry.texture)
+    {
+        SDL_DestroyTexture(entry.texture);
+        entry.texture = nullptr;
+    }
+    if (entry.surface)
+    {
+        SDL_FreeSurface(entry.surface);
+        entry.surface = nullptr;
+    }
+    entry.w = entry.h = 0;
+}
+
+SDL_Surface *UIManager::renderTextSurface(const std::string &text, SDL_Color color)
+{
+    if (text.empty())
+    {
+        return nullptr;
+    }
     if (!font)
     {
         std::cerr << "Font not loaded!" << std::endl;
-        return;
+        return nullptr;
     }
-    SDL_Surface *surface = TTF_RenderText_Blended(font, text.c_str(), color);
+    SDL_Surface *surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
     if (!surface)
     {
-        std::cerr << "TTF_RenderText_Blended Error: " << TTF_GetError() << std::endl;
+        std::cerr << "TTF_RenderUTF8_Blended Error: " << TTF_GetError() << std::endl;
+    }
+    return surface;
+}
+
+// Rasterizes entry.text on this thread. Callers only do this when the text changed, so frames
+// without a state change reuse the result and allocate nothing.
+void UIManager::rasterizeText(CachedText &entry, SDL_Color color)
+{
+    releaseText(entry);
+    SDL_Surface *surface = renderTextSurface(entry.text, color);
+    if (surface)
+    {
+        adoptSurface(entry, surface);
+    }
+}
+
+// Takes ownership of surface and keeps whatever the current mode draws from:
+// an ARGB8888 surface in Framebuffer mode, a texture in Renderer mode.
+void UIManager::adoptSurface(CachedText &entry, SDL_Surface *surface)
+{
+    releaseText(entry);
+    entry.w = surface->w;
+    entry.h = surface->h;
+
+    if (renderMode == RenderMode::Framebuffer)
+    {
+        // blitSurface() reads ARGB8888 directly, so convert once here rather than on every draw
+        if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+        {
+            SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            SDL_FreeSurface(surface);
+            if (!converted)
+            {
+                std::cerr << "SDL_ConvertSurfaceFormat Error: " << SDL_GetError() << std::endl;
+                entry.w = entry.h = 0;
+                return;
+            }
+            surface = converted;
+        }
+        entry.surface = surface;
         return;
     }
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(m_renderer, surface);
-    if (!texture)
+
+    entry.texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+    if (!entry.texture)
     {
         std::cerr << "SDL_CreateTextureFromSurface Error: " << SDL_GetError() << std::endl;
     }
-    SDL_Rect dstRect = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(m_renderer, texture, NULL, &dstRect);
-    SDL_DestroyTexture(texture);
     SDL_FreeSurface(surface);
 }
 
+// Takes ownership of surface for a row. In Renderer mode the pixels are copied into the slot's own
+// texture, so bringing a new row on screen creates and destroys nothing. Labels wider than the
+// cell are cut at its padding.
+void UIManager::adoptRowSurface(CachedRow &row, SDL_Surface *surface)
+{
+    if (renderMode == RenderMode::Framebuffer || !rowTexturesPooled)
+    {
+        adoptSurface(row.text, surface);
+        row.text.w = std::min(row.text.w, rowTextWidth);
+        row.text.h = std::min(row.text.h, rowTextHeight);
+        return;
+    }
+
+    row.text.w = row.text.h = 0;
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+    {
+        SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        if (!converted)
+        {
+            std::cerr << "SDL_ConvertSurfaceFormat Error: " << SDL_GetError() << std::endl;
+            return;
+        }
+        surface = converted;
+    }
+
+    SDL_Rect area = {0, 0, std::min(surface->w, rowTextWidth), std::min(surface->h, rowTextHeight)};
+    if (SDL_UpdateTexture(row.text.texture, &area, surface->pixels, surface->pitch) == 0)
+    {
+        row.text.w = area.w;
+        row.text.h = area.h;
+    }
+    else
+    {
+        std::cerr << "SDL_UpdateTexture Error: " << SDL_GetError() << std::endl;
+    }
+    SDL_FreeSurface(surface);
+}
+
+void UIManager::drawText(const CachedText &entry, int x, int y)
+{
+    if (renderMode == RenderMode::Framebuffer)
+    {
+        if (entry.surface)
+        {
+            blitSurface(entry.surface, x, y, entry.w, entry.h);
+        }
+        return;
+    }
+    if (!entry.texture || entry.w == 0)
+    {
+        return;
+    }
+    // Pooled row textures are larger than their label, only the label's corner is drawn
+    SDL_Rect srcRect = {0, 0, entry.w, entry.h};
+    SDL_Rect dstRect = {x, y, entry.w, entry.h};
+    SDL_RenderCopy(m_renderer, entry.texture, &srcRect, &dstRect);
+}
+
+// Rebuilds the row slots. In Renderer mode each slot gets one texture, sized for the widest label
+// that fits a cell, which every row cached in that slot is uploaded into.
+void UIManager::resizeRowCache(size_t size)
+{
+    for (CachedRow &row : rowCache)
+    {
+        releaseText(row.text);
+    }
+    rowCache.clear();
+    rowCache.resize(size);
+
+    const int cellWidth = screenWidth - LEFT_MARGIN - (SCROLLBAR_WIDTH + SCROLLBAR_MARGIN_RIGHT + SCROLLBAR_TO_LINE_PADDING);
+    rowTextWidth = std::max(1, cellWidth - 2 * CELL_PADDING_X);
+    rowTextHeight = font ? std::max(1, TTF_FontHeight(font)) : LINE_HEIGHT;
+    rowTexturesPooled = renderMode == RenderMode::Renderer;
+
+    for (CachedRow &row : rowCache)
+    {
+        row.text.text.reserve(ROW_TEXT_RESERVE);
+        if (!rowTexturesPooled)
+        {
+            continue;
+        }
+        row.text.texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, rowTextWidth, rowTextHeight);
+        if (!row.text.texture)
+        {
+            std::cerr << "SDL_CreateTexture Error: " << SDL_GetError() << ", creating row textures on demand." << std::endl;
+            rowTexturesPooled = false;
+            for (CachedRow &created : rowCache)
+            {
+                releaseText(created.text);
+            }
+            continue;
+        }
+        SDL_SetTextureBlendMode(row.text.texture, SDL_BLENDMODE_BLEND);
+    }
+}
+
 void UIManager::drawCurrentPath(const std::string &path)
 {
-    drawText("Current Path: " + path, LEFT_MARGIN, 20, WHITE_COLOR);
+    // Compare against the cached label in place so an unchanged path costs no allocation
+    const size_t prefixLength = sizeof(CURRENT_PATH_PREFIX) - 1;
+    std::string &label = pathLabel.text;
+    if (label.size() != prefixLength + path.size() || label.compare(prefixLength, std::string::npos, path) != 0)
+    {
+        label.assign(CURRENT_PATH_PREFIX);
+        label.append(path);
+        rasterizeText(pathLabel, WHITE_COLOR);
+    }
+    drawText(pathLabel, LEFT_MARGIN, 20);
 
     // Calculate endX for the line to avoid scrollbar
     int lineEndX = screenWidth - SCROLLBAR_WIDTH - SCROLLBAR_MARGIN_RIGHT - SCROLLBAR_TO_LINE_PADDING;
     drawHorizontalLine(20 + fontSize + 10, HIGHLIGHT_BORDER_THICKNESS, WHITE_COLOR, LEFT_MARGIN, lineEndX);
 }
 
-void UIManager::drawFileList(const std::vector<FileItem> &items, int selectedIndex, int scrollOffset, int visibleItemsCount)
+void UIManager::queueRowJob(const std::vector<FileItem> &items, Uint32 listingGeneration, int itemIndex)
 {
+    if (itemIndex < 0 || itemIndex >= (int)items.size() || stagedJobs.size() >= MAX_PREFETCH_JOBS)
+    {
+        return;
+    }
+    prefetchFirst = std::min(prefetchFirst, itemIndex);
+    prefetchLast = std::max(prefetchLast, itemIndex);
+
+    const CachedRow &row = rowCache[itemIndex % rowCache.size()];
+    if (row.itemIndex == itemIndex && row.listingGeneration == listingGeneration)
+    {
+        return;
+    }
+
+    const FileItem &item = items[itemIndex];
+    TextRasterizer::Job job;
+    job.listingGeneration = listingGeneration;
+    job.itemIndex = itemIndex;
+    size_t length = std::min(item.name.size(), (size_t)TextRasterizer::MAX_TEXT_BYTES - 2);
+    std::memcpy(job.text, item.name.data(), length);
+    if (item.isDirectory)
+    {
+        job.text[length++] = '/';
+    }
+    job.text[length] = '\0';
+    stagedJobs.push_back(job);
+}
+
+// Called when the list scrolls or changes. Queues the visible rows, then a screen ahead in the
+// direction of travel, then half a screen behind, skipping rows that are already cached.
+void UIManager::scheduleRowPrefetch(const std::vector<FileItem> &items, Uint32 listingGeneration, int scrollOffset, int visibleItemsCount)
+{
+    if (listingGeneration != lastListingGeneration)
+    {
+        scrollDirection = 1;
+    }
+    else if (scrollOffset != lastScrollOffset)
+    {
+        scrollDirection = scrollOffset > lastScrollOffset ? 1 : -1;
+    }
+    lastListingGeneration = listingGeneration;
+    lastScrollOffset = scrollOffset;
+
+    // Visible rows go first, from the top, so a new listing starts on the worker straight away.
+    // drawFileList() rasterizes the same rows from the bottom up and the two meet in the middle.
+    prefetchFirst = scrollOffset;
+    prefetchLast = scrollOffset + visibleItemsCount - 1;
+    for (int i = 0; i < visibleItemsCount; ++i)
+    {
+        queueRowJob(items, listingGeneration, scrollOffset + i);
+    }
+
+    const int leading = visibleItemsCount;
+    const int trailing = visibleItemsCount / 2;
+    for (int i = 0; i < leading; ++i)
+    {
+        queueRowJob(items, listingGeneration, scrollDirection > 0 ? scrollOffset + visibleItemsCount + i : scrollOffset - 1 - i);
+    }
+    for (int i = 0; i < trailing; ++i)
+    {
+        queueRowJob(items, listingGeneration, scrollDirection > 0 ? scrollOffset - 1 - i : scrollOffset + visibleItemsCount + i);
+    }
+
+    rowRasterizer->submit(stagedJobs);
+}
+
+// Moves finished worker surfaces into the row cache until deadline, at least one per call.
+// Rows that scrolled out of the prefetch window or belong to an old listing are dropped.
+void UIManager::uploadReadyRows(Uint32 listingGeneration, Uint64 deadline)
+{
+    if (readyRowsConsumed == readyRows.size())
+    {
+        readyRows.clear();
+        readyRowsConsumed = 0;
+        rowRasterizer->collectResults(readyRows);
+    }
+
+    bool uploadedAny = false;
+    while (readyRowsConsumed < readyRows.size())
+    {
+        if (uploadedAny && SDL_GetPerformanceCounter() > deadline)
+        {
+            break;
+        }
+
+        TextRasterizer::Result &result = readyRows[readyRowsConsumed++];
+        CachedRow &row = rowCache[result.itemIndex % rowCache.size()];
+        bool wanted = result.listingGeneration == listingGeneration &&
+                      result.itemIndex >= prefetchFirst && result.itemIndex <= prefetchLast &&
+                      !(row.itemIndex == result.itemIndex && row.listingGeneration == listingGeneration);
+        if (!wanted)
+        {
+            SDL_FreeSurface(result.surface);
+            continue;
+        }
+
+        row.text.text.clear();
+        adoptRowSurface(row, result.surface);
+        row.itemIndex = result.itemIndex;
+        row.listingGeneration = result.listingGeneration;
+        uploadedAny = true;
+    }
+}
+
+// Rasterizes visible rows that are still missing on this thread, from the bottom of the screen up
+// while the worker works down from the top, collecting its results in between. Stops at deadline
+// after at least one row; rows left over are drawn without a label and fill in on a later frame.
+// Returns true when it rasterized anything.
+bool UIManager::rasterizeMissingRows(const std::vector<FileItem> &items, Uint32 listingGeneration, int scrollOffset, int visibleItemsCount, Uint64 deadline)
+{
+    bool rasterizedAny = false;
+    int last = std::min(scrollOffset + visibleItemsCount, (int)items.size()) - 1;
+    for (int itemIndex = last; itemIndex >= scrollOffset; --itemIndex)
+    {
+        CachedRow &row = rowCache[itemIndex % rowCache.size()];
+        if (row.itemIndex == itemIndex && row.listingGeneration == listingGeneration)
+        {
+            continue;
+        }
+        if (rowRasterizer)
+        {
+            uploadReadyRows(listingGeneration, deadline);
+            if (row.itemIndex == itemIndex && row.listingGeneration == listingGeneration)
+            {
+                continue;
+            }
+        }
+        if (rasterizedAny && SDL_GetPerformanceCounter() > deadline)
+        {
+            break;
+        }
+
+        row.text.text.assign(items[itemIndex].name);
+        if (items[itemIndex].isDirectory)
+        {
+            row.text.text += '/';
+        }
+        row.itemIndex = itemIndex;
+        row.listingGeneration = listingGeneration;
+        row.text.w = row.text.h = 0;
+        rowCacheMisses++;
+        rasterizedAny = true;
+        SDL_Surface *surface = renderTextSurface(row.text.text, WHITE_COLOR);
+        if (surface)
+        {
+            adoptRowSurface(row, surface);
+        }
+    }
+    return rasterizedAny;
+}
+
+void UIManager::drawFileList(const std::vector<FileItem> &items, Uint32 listingGeneration, int selectedIndex, int scrollOffset, int visibleItemsCount)
+{
+    size_t rowCacheSize = (size_t)std::max(visibleItemsCount, 1) * ROW_CACHE_SCREENS;
+    if (rowCache.size() != rowCacheSize)
+    {
+        resizeRowCache(rowCacheSize);
+        lastScrollOffset = -1;
+    }
+
+    // Uploading worker rows and rasterizing missing ones share one budget, so opening a directory
+    // costs a bounded amount of this frame however many rows it shows
+    const Uint64 deadline = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() * ROW_UPLOAD_BUDGET_US / 1000000;
+    if (rowRasterizer)
+    {
+        if (listingGeneration != lastListingGeneration || scrollOffset != lastScrollOffset)
+        {
+            scheduleRowPrefetch(items, listingGeneration, scrollOffset, visibleItemsCount);
+        }
+        uploadReadyRows(listingGeneration, deadline);
+    }
+    if (rasterizeMissingRows(items, listingGeneration, scrollOffset, visibleItemsCount, deadline) && rowRasterizer)
+    {
+        // Drop the rows done here from the worker's queue
+        scheduleRowPrefetch(items, listingGeneration, scrollOffset, visibleItemsCount);
+    }
+
     // List starts after the path text and separator line
     // Path text (fontSize) at Y=20, separator at Y=20+fontSize+10, give some padding after line
     int startY = 20 + fontSize + 10 + HIGHLIGHT_BORDER_THICKNESS + 10; // Start Y for the first file cell
-    const int CELL_PADDING_X = 10;
     // Adjust CELL_WIDTH to account for scrollbar area
     const int CELL_WIDTH = screenWidth - LEFT_MARGIN - (SCROLLBAR_WIDTH + SCROLLBAR_MARGIN_RIGHT + SCROLLBAR_TO_LINE_PADDING);
 
@@ -135,12 +677,8 @@ void UIManager::drawFileList(const std::vector<FileItem> &items, int selectedInd
         int itemIndex = scrollOffset + i;
         if (itemIndex >= 0 && itemIndex < items.size())
         {
-            std::string displayName = items[itemIndex].name;
-
-            if (items[itemIndex].isDirectory)
-            {
-                displayName += "/";
-            }
+            const CachedRow &row = rowCache[itemIndex % rowCache.size()];
+            bool cached = row.itemIndex == itemIndex && row.listingGeneration == listingGeneration;
 
             // Calculate cell position and size, accounting for spacing
             SDL_Rect cellRect = {
@@ -155,11 +693,14 @@ void UIManager::drawFileList(const std::vector<FileItem> &items, int selectedInd
             }
             else
             {
-                SDL_SetRenderDrawColor(m_renderer, DEFAULT_CELL_BORDER_COLOR.r, DEFAULT_CELL_BORDER_COLOR.g, DEFAULT_CELL_BORDER_COLOR.b, DEFAULT_CELL_BORDER_COLOR.a);
-                SDL_RenderDrawRect(m_renderer, &cellRect);
+                drawRect(cellRect, DEFAULT_CELL_BORDER_COLOR);
             }
 
-            drawText(displayName, cellRect.x + CELL_PADDING_X, cellRect.y + (cellRect.h - fontSize) / 2, WHITE_COLOR);
+            // The slot of a row not rasterized yet still holds another item's label
+            if (cached)
+            {
+                drawText(row.text, cellRect.x + CELL_PADDING_X, cellRect.y + (cellRect.h - fontSize) / 2);
+            }
         }
     }
 }
@@ -179,13 +720,11 @@ void UIManager::drawScrollbar(int totalItems, int visibleItems, int scrollOffset
     float scrollRatio = (float)scrollOffset / (totalItems - visibleItems);
     int thumbY = 20 + (int)((scrollbarHeight - thumbHeight) * scrollRatio); // Start Y for the scrollbar track is 20
 
-    SDL_SetRenderDrawColor(m_renderer, 0x40, 0x40, 0x40, 0xFF); // Dark gray background for scrollbar track
     SDL_Rect scrollbarBgRect = {scrollbarX, 20, SCROLLBAR_WIDTH, scrollbarHeight};
-    SDL_RenderFillRect(m_renderer, &scrollbarBgRect);
+    fillRect(scrollbarBgRect, SCROLLBAR_TRACK_COLOR); // Dark gray background for scrollbar track
 
-    SDL_SetRenderDrawColor(m_renderer, 0x80, 0x80, 0x80, 0xFF); // Lighter gray for scrollbar thumb
     SDL_Rect thumbRect = {scrollbarX, thumbY, SCROLLBAR_WIDTH, thumbHeight};
-    SDL_RenderFillRect(m_renderer, &thumbRect);
+    fillRect(thumbRect, SCROLLBAR_THUMB_COLOR); // Lighter gray for scrollbar thumb
 }
 
 void UIManager::drawHelpText(const std::string &text, int visibleItemsCount)
@@ -207,7 +746,12 @@ void UIManager::drawHelpText(const std::string &text, int visibleItemsCount)
 
     int lineEndX = screenWidth - SCROLLBAR_WIDTH - SCROLLBAR_MARGIN_RIGHT - SCROLLBAR_TO_LINE_PADDING;
     drawHorizontalLine(lineTopY, HIGHLIGHT_BORDER_THICKNESS, WHITE_COLOR, LEFT_MARGIN, lineEndX);
-    drawText(text, LEFT_MARGIN, textY, WHITE_COLOR);
+    if (helpText.text != text)
+    {
+        helpText.text = text;
+        rasterizeText(helpText, WHITE_COLOR);
+    }
+    drawText(helpText, LEFT_MARGIN, textY);
 }
 
 int UIManager::getScreenWidth() const